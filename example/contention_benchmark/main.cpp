@@ -0,0 +1,110 @@
+/**
+ * @file main.cpp
+ * @brief Host benchmark: packed vs. cache-line-aligned feed state
+ *
+ * Host threads stand in for tasks on different cores. Each thread feeds
+ * its own slot the way Watchdog::feedSlot() does (a deadline store, or a
+ * counter update when the feed is coalesced). With the packed layout,
+ * neighbouring slots share a cache line that bounces between cores; with
+ * the aligned layout (WATCHDOG_CACHE_ALIGNED_SLOTS) every slot owns its line.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+static const size_t MAX_THREADS = 16;
+static const uint32_t FEEDS_PER_THREAD = 20000000;
+static const uint32_t GRACE = 200;
+
+// Packed layout: one deadline array, one counter array
+struct PackedRegistry {
+    std::atomic<uint32_t> deadlines[MAX_THREADS];
+    std::atomic<uint32_t> coalescedFeeds[MAX_THREADS];
+
+    void feed(size_t slot, uint32_t now) {
+        deadlines[slot].store(now + GRACE, std::memory_order_release);
+    }
+    void coalesce(size_t slot) {
+        coalescedFeeds[slot].store(coalescedFeeds[slot].load(std::memory_order_relaxed) + 1,
+                                   std::memory_order_relaxed);
+    }
+};
+
+// Aligned layout: one cache line per slot
+struct AlignedRegistry {
+    struct alignas(64) Cell {
+        std::atomic<uint32_t> deadline;
+        std::atomic<uint32_t> coalescedFeeds;
+    };
+    Cell cells[MAX_THREADS];
+
+    void feed(size_t slot, uint32_t now) {
+        cells[slot].deadline.store(now + GRACE, std::memory_order_release);
+    }
+    void coalesce(size_t slot) {
+        std::atomic<uint32_t>& counter = cells[slot].coalescedFeeds;
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+// Static storage keeps the aligned layout aligned without C++17 aligned new
+static PackedRegistry packedRegistry;
+static AlignedRegistry alignedRegistry;
+
+template <typename Registry>
+static double nanosPerFeed(Registry* registry, size_t threads, bool coalesced) {
+    for (size_t i = 0; i < MAX_THREADS; i++) {
+        registry->feed(i, 0);
+    }
+    std::atomic<size_t> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; t++) {
+        workers.push_back(std::thread([registry, t, coalesced, &ready, &go]() {
+            ready++;
+            while (!go.load()) {
+            }
+            for (uint32_t i = 0; i < FEEDS_PER_THREAD; i++) {
+                if (coalesced) {
+                    registry->coalesce(t);
+                } else {
+                    registry->feed(t, i);
+                }
+            }
+        }));
+    }
+    while (ready.load() < threads) {
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    go.store(true);
+    for (size_t t = 0; t < threads; t++) {
+        workers[t].join();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / FEEDS_PER_THREAD;
+}
+
+int main() {
+    size_t cores = std::thread::hardware_concurrency();
+    if (cores == 0 || cores > MAX_THREADS) {
+        cores = MAX_THREADS;
+    }
+    printf("Feed state: %u bytes packed, %u bytes aligned per slot\n",
+           (unsigned)(2 * sizeof(std::atomic<uint32_t>)),
+           (unsigned)sizeof(AlignedRegistry::Cell));
+    printf("%8s %10s %12s %12s %8s\n", "threads", "feed", "packed ns", "aligned ns", "speedup");
+    for (size_t threads = 1; threads <= cores; threads *= 2) {
+        for (int coalesced = 0; coalesced <= 1; coalesced++) {
+            double packed = nanosPerFeed(&packedRegistry, threads, coalesced != 0);
+            double aligned = nanosPerFeed(&alignedRegistry, threads, coalesced != 0);
+            printf("%8u %10s %12.2f %12.2f %7.2fx\n", (unsigned)threads,
+                   coalesced ? "coalesced" : "full", packed, aligned, packed / aligned);
+        }
+    }
+    return 0;
+}
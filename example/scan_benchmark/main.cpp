@@ -0,0 +1,165 @@
+/**
+ * @file main.cpp
+ * @brief Host benchmarks for the registry's scan kernel and lookup index
+ *
+ * Health scan: one record per task (the layout used before the registry
+ * was split into hot and cold arrays) vs. WatchdogScan::markOverdue() over
+ * the hot deadline and flag arrays. Roughly one task in eight is overdue.
+ *
+ * Lookup by handle: linear scan of the handle array vs. a
+ * WatchdogIndex::SlotIndex probe, averaged over every registered handle.
+ *
+ * Both run for 16 to 4096 entries.
+ */
+
+#include <WatchdogScan.h>
+#include <WatchdogIndex.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+typedef uint32_t Tick;
+
+// One record per task, as checkHealth() used to scan it
+struct TaskRecord {
+    std::atomic<void*> handle;
+    char name[16];
+    std::atomic<Tick> lastFeedTime;
+    uint32_t feedIntervalMs;
+    std::atomic<uint32_t> missedFeeds;
+    std::atomic<uint32_t> coalescedFeeds;
+    bool isCritical;
+    bool twdtSubscribed;
+    bool isHeartbeat;
+};
+
+static size_t scanRecords(const TaskRecord* records, size_t count, Tick now, uint8_t* overdue) {
+    size_t overdueCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        overdue[i] = 0;
+        if (!records[i].handle.load(std::memory_order_acquire)) {
+            continue;
+        }
+        Tick sinceFeed = now - records[i].lastFeedTime.load(std::memory_order_acquire);
+        if (sinceFeed > records[i].feedIntervalMs * 2) {
+            overdue[i] = 1;
+            overdueCount++;
+        }
+    }
+    return overdueCount;
+}
+
+template <typename Fn>
+static double nanosPerScan(Fn fn, size_t scans) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < scans; i++) {
+        fn();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / scans;
+}
+
+static const size_t MAX_ENTRIES = 4096;
+typedef WatchdogIndex::SlotIndex<WatchdogIndex::bucketsFor(MAX_ENTRIES)> HandleIndex;
+
+static HandleIndex handleIndex;
+static std::atomic<void*> handles[MAX_ENTRIES];
+
+static size_t scanHandles(size_t count, void* handle) {
+    for (size_t i = 0; i < count; i++) {
+        if (handles[i].load(std::memory_order_acquire) == handle) {
+            return i;
+        }
+    }
+    return count;
+}
+
+static size_t indexLookup(void* handle) {
+    return handleIndex.find(WatchdogIndex::hashPointer(handle), [handle](uint16_t slot) {
+        return handles[slot].load(std::memory_order_acquire) == handle;
+    });
+}
+
+static int benchmarkLookups() {
+    // Stand-in task handles: distinct, aligned heap addresses
+    std::vector<uint64_t> tasks(MAX_ENTRIES);
+    volatile size_t sink = 0;
+
+    printf("\n%8s %14s %14s %8s\n", "entries", "linear ns", "index ns", "speedup");
+    for (size_t count = 16; count <= MAX_ENTRIES; count *= 2) {
+        handleIndex.clear();
+        for (size_t i = 0; i < count; i++) {
+            handles[i].store(&tasks[i]);
+            handleIndex.insert(WatchdogIndex::hashPointer(&tasks[i]), static_cast<uint16_t>(i));
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (indexLookup(&tasks[i]) != i) {
+                printf("Index lookup failed at %u entries\n", (unsigned)count);
+                return 1;
+            }
+        }
+
+        size_t rounds = (1u << 22) / count;
+        double linearNs = nanosPerScan([&]() {
+            for (size_t i = 0; i < count; i++) {
+                sink += scanHandles(count, &tasks[i]);
+            }
+        }, rounds) / count;
+        double indexNs = nanosPerScan([&]() {
+            for (size_t i = 0; i < count; i++) {
+                sink += indexLookup(&tasks[i]);
+            }
+        }, rounds) / count;
+        printf("%8u %14.1f %14.1f %7.2fx\n", (unsigned)count, linearNs, indexNs,
+               linearNs / indexNs);
+    }
+    return 0;
+}
+
+int main() {
+    const uint8_t ACTIVE = 0x01;
+    const Tick NOW = 100000;
+    volatile size_t sink = 0;
+
+    printf("%8s %14s %14s %8s\n", "entries", "records ns", "kernel ns", "speedup");
+    for (size_t count = 16; count <= 4096; count *= 2) {
+        std::vector<TaskRecord> records(count);
+        std::vector<std::atomic<Tick> > deadlines(count);
+        std::vector<std::atomic<uint8_t> > flags(count);
+        std::vector<uint8_t> overdue(count);
+
+        for (size_t i = 0; i < count; i++) {
+            // Every slot in use; every eighth task stopped feeding
+            Tick interval = 100;
+            Tick lastFeed = (i % 8 == 0) ? NOW - 10 * interval : NOW - interval / 2;
+            records[i].handle.store(&records[i]);
+            snprintf(records[i].name, sizeof(records[i].name), "Task%u", (unsigned)i);
+            records[i].lastFeedTime.store(lastFeed);
+            records[i].feedIntervalMs = interval;
+            deadlines[i].store(lastFeed + 2 * interval);
+            flags[i].store(ACTIVE);
+        }
+
+        size_t scans = (1u << 24) / count;
+        size_t expected = scanRecords(&records[0], count, NOW, &overdue[0]);
+        if (WatchdogScan::markOverdue(&deadlines[0], &flags[0], count, NOW, ACTIVE,
+                                      &overdue[0]) != expected) {
+            printf("Mismatch at %u entries\n", (unsigned)count);
+            return 1;
+        }
+
+        double recordNs = nanosPerScan([&]() {
+            sink += scanRecords(&records[0], count, NOW, &overdue[0]);
+        }, scans);
+        double kernelNs = nanosPerScan([&]() {
+            sink += WatchdogScan::markOverdue(&deadlines[0], &flags[0], count, NOW, ACTIVE,
+                                              &overdue[0]);
+        }, scans);
+        printf("%8u %14.1f %14.1f %7.2fx\n", (unsigned)count, recordNs, kernelNs,
+               recordNs / kernelNs);
+    }
+    return benchmarkLookups();
+}
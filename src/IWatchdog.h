@@ -25,12 +25,17 @@
  * Watchdog implementation to enable testing and flexibility.
  */
 class IWatchdog {
-public:
+protected:
     /**
-     * @brief Virtual destructor for proper cleanup
+     * @brief Protected and non-virtual: implementations are never deleted
+     *        through the interface
+     *
+     * Keeps the destructors of implementations trivial, so the Watchdog
+     * singleton is constant-initialized without an exit-time destructor.
      */
-    virtual ~IWatchdog() = default;
+    ~IWatchdog() = default;
 
+public:
     // ============== Lifecycle Methods ==============
 
     /**
@@ -4,10 +4,25 @@
  */
 
 #include "Watchdog.h"
-#include <algorithm>
+
+Watchdog Watchdog::instance_;
+
+WATCHDOG_COLD_ATTR Watchdog::SlotDetails Watchdog::slotDetails_[Watchdog::MAX_TASKS];
+#ifdef WATCHDOG_COMPACT_TASKINFO
+WATCHDOG_COLD_ATTR Watchdog::NameEntry Watchdog::names_[Watchdog::NAME_TABLE_SIZE];
+#endif
 
 bool Watchdog::init(uint32_t timeoutSeconds, bool panicOnTimeout) noexcept {
+    return initWithStaticTasks(timeoutSeconds, panicOnTimeout, nullptr, 0);
+}
+
+bool Watchdog::initWithStaticTasks(uint32_t timeoutSeconds, bool panicOnTimeout,
+                                   const StaticTaskSpec* tasks, size_t count) {
     if (initialized_) {
+        if (count > 0) {
+            WDOG_LOG_E("Cannot reserve static tasks: watchdog already initialized");
+            return false;
+        }
         WDOG_LOG_W("Watchdog already initialized");
         return true;
     }
@@ -17,24 +32,106 @@ bool Watchdog::init(uint32_t timeoutSeconds, bool panicOnTimeout) noexcept {
         return false;
     }
     
-    timeoutMs_ = timeoutSeconds * 1000;
+    if (!taskListMutex_) {
+        // Created here rather than by the constructor, so that the singleton
+        // needs no FreeRTOS call before the scheduler is up
+        taskListMutex_ = xSemaphoreCreateMutexStatic(&taskListMutexBuffer_);
+        if (!taskListMutex_) {
+            WDOG_LOG_E("Failed to create registry mutex");
+            return false;
+        }
+    }
+    for (size_t i = 0; i < SHARDS; i++) {
+        Shard& shard = shards_[i];
+        if (!shard.healthMutex) {
+            shard.healthMutex = xSemaphoreCreateMutexStatic(&shard.healthMutexBuffer);
+            if (!shard.healthMutex) {
+                WDOG_LOG_E("Failed to create shard %u mutex", (unsigned)i);
+                return false;
+            }
+        }
+    }
+    
+    timeoutMs_.store(timeoutSeconds * 1000, std::memory_order_relaxed);
     panicOnTimeout_ = panicOnTimeout;
     
+    if (!reserveStaticSlots(tasks, count)) {
+        return false;
+    }
+    
     esp_err_t err = initWatchdogESPIDF();
     
     if (err == ESP_OK) {
-        initialized_ = true;
         WDOG_LOG_I("Watchdog initialized with %lu second timeout", timeoutSeconds);
-        return true;
     } else if (err == ESP_ERR_INVALID_STATE) {
         // Already initialized by someone else
-        initialized_ = true;
         WDOG_LOG_D("Watchdog was already initialized by another component");
-        return true;
     } else {
         WDOG_LOG_E("Failed to initialize watchdog: 0x%x", err);
+        if (lockRegistry(portMAX_DELAY)) {
+            clearStaticSlots();
+            xSemaphoreGive(taskListMutex_);
+        }
         return false;
     }
+    
+    // Queued registrations are applied before initialized_ is set, so a
+    // task unregistering meanwhile waits for them instead of missing its own
+    applyDeferredRegistrations();
+    initialized_ = true;
+    return true;
+}
+
+bool Watchdog::reserveStaticSlots(const StaticTaskSpec* tasks, size_t count) {
+    // Not initialized yet, so no registration can be claiming slots
+    uint32_t timeoutMs = getTimeoutMs();
+    for (size_t i = 0; i < count; i++) {
+        const StaticTaskSpec& task = tasks[i];
+        uint32_t intervalMs = (task.feedIntervalMs > 0) ? task.feedIntervalMs : (timeoutMs / 5);
+        bool valid = task.name != nullptr && 2ULL * intervalMs < timeoutMs;
+        if (!valid) {
+            WDOG_LOG_E("Static task %u: feed interval %lums does not fit %lums timeout",
+                     (unsigned)i, intervalMs, timeoutMs);
+        }
+        if (!valid || !setSlotDetails(i, task.name, task.isCritical, intervalMs)) {
+            if (lockRegistry(portMAX_DELAY)) {
+                clearStaticSlots();
+                xSemaphoreGive(taskListMutex_);
+            }
+            return false;
+        }
+        graceTicks_[i] = pdMS_TO_TICKS(slotIntervalMs(i) * 2);
+        slotFlags_[i].store(SLOT_RESERVED, std::memory_order_relaxed);
+        staticTaskCount_ = i + 1;
+    }
+    resetFreeList(count);
+    return true;
+}
+
+void Watchdog::clearStaticSlots() {
+    for (size_t i = 0; i < staticTaskCount_; i++) {
+#ifdef WATCHDOG_COMPACT_TASKINFO
+        names_[slotDetails_[i].nameRef].refs--;
+#endif
+        slotFlags_[i].store(0, std::memory_order_relaxed);
+    }
+    staticTaskCount_ = 0;
+    resetFreeList(0);
+}
+
+void Watchdog::resetFreeList(size_t first) {
+    for (size_t shard = 0; shard < SHARDS; shard++) {
+        size_t begin = (shardBegin(shard) > first) ? shardBegin(shard) : first;
+        size_t end = shardEnd(shard);
+        for (size_t i = begin; i < end; i++) {
+            nextFree_[i].store((i + 1 < end) ? static_cast<uint16_t>(i + 1) : FREE_END,
+                               std::memory_order_relaxed);
+        }
+        std::atomic<uint32_t>& freeHead = shards_[shard].freeHead;
+        uint32_t counter = (freeHead.load(std::memory_order_relaxed) + 0x10000) & 0xFFFF0000;
+        uint16_t head = (begin < end) ? static_cast<uint16_t>(begin) : FREE_END;
+        freeHead.store(counter | head, std::memory_order_release);
+    }
 }
 
 bool Watchdog::deinit() noexcept {
@@ -43,81 +140,765 @@ bool Watchdog::deinit() noexcept {
     }
     
     // Unregister all tasks
-    if (xSemaphoreTake(taskListMutex_, portMAX_DELAY) == pdTRUE) {
-        for (auto& task : registeredTasks_) {
-            esp_task_wdt_delete(task.handle);
+    size_t released = 0;
+    if (lockRegistry(portMAX_DELAY)) {
+        for (size_t i = 0; i < MAX_TASKS; i++) {
+            TaskHandle_t handle = slotHandles_[i].load();
+            if (handle && (slotFlags_[i].load(std::memory_order_relaxed) & SLOT_TWDT)) {
+                esp_task_wdt_delete(handle);
+            }
         }
-        registeredTasks_.clear();
+        released = releaseAllSlots();
+        clearStaticSlots();
+        publishSnapshot();
         xSemaphoreGive(taskListMutex_);
     }
     
     // Note: ESP-IDF doesn't provide a way to fully deinit the TWDT
-    // We can only remove all tasks from it
+    // We can only remove all tasks from it. The queue is reopened first, as
+    // a closed queue with initialized_ clear means init() is applying it.
+    reopenDeferredRegistrations();
     initialized_ = false;
-    WDOG_LOG_I("Watchdog deinitialized");
+    WDOG_LOG_I("Watchdog deinitialized (%u tasks unregistered)", (unsigned)released);
     return true;
 }
 
 bool Watchdog::registerCurrentTask(const char* taskName, bool isCritical, uint32_t feedIntervalMs) noexcept {
-    if (!initialized_) {
-        WDOG_LOG_E("Watchdog not initialized");
+    if (!initialized_.load(std::memory_order_acquire)) {
+        DeferResult deferred = deferRegistration(taskName, isCritical, feedIntervalMs);
+        if (deferred != DEFER_CLOSED) {
+            return deferred == DEFERRED;
+        }
+    }
+    return registerCurrentTaskSlot(taskName, isCritical, feedIntervalMs) != NO_SLOT;
+}
+
+#if WATCHDOG_PENDING_REGISTRATIONS > 0
+Watchdog::DeferResult Watchdog::deferRegistration(const char* taskName, bool isCritical,
+                                                  uint32_t feedIntervalMs) {
+    // No task before the scheduler starts, so nothing to register later
+    TaskHandle_t currentTask = xTaskGetCurrentTaskHandle();
+    if (!currentTask) {
+        return DEFER_CLOSED;
+    }
+    
+    uint32_t state = pendingState_.load(std::memory_order_acquire);
+    if (state & PENDING_CLOSED) {
+        return DEFER_CLOSED;
+    }
+    
+    // Reuse an entry withdrawn by unregisterCurrentTask(), so that tasks
+    // registering and unregistering before init() cannot fill the queue.
+    // If init() gets to the entry first, it finds it being filled and waits.
+    PendingRegistration* reused = nullptr;
+    for (size_t i = 0; i < state && !reused; i++) {
+        uint8_t cancelled = PENDING_CANCELLED;
+        if (pending_[i].state.compare_exchange_strong(cancelled, PENDING_EMPTY,
+                                                      std::memory_order_acquire)) {
+            reused = &pending_[i];
+        }
+    }
+    
+    // Otherwise reserve a new one; init() closes the queue before reading it
+    if (!reused) {
+        do {
+            if (state & PENDING_CLOSED) {
+                return DEFER_CLOSED;
+            }
+            if (state >= PENDING_REGISTRATIONS) {
+                WDOG_LOG_E("Cannot queue task %s: %u registrations already wait for init()",
+                         taskName ? taskName : "", (unsigned)PENDING_REGISTRATIONS);
+                return DEFER_FULL;
+            }
+        } while (!pendingState_.compare_exchange_weak(state, state + 1, std::memory_order_acquire,
+                                                      std::memory_order_relaxed));
+    }
+    
+    PendingRegistration& entry = reused ? *reused : pending_[state];
+    entry.handle = currentTask;
+    entry.feedIntervalMs = feedIntervalMs;
+    memset(entry.name, 0, MAX_TASK_NAME_LEN);
+    if (taskName) {
+        strncpy(entry.name, taskName, MAX_TASK_NAME_LEN - 1);
+    }
+    entry.isCritical = isCritical;
+    entry.state.store(PENDING_READY, std::memory_order_release);
+    
+    WDOG_LOG_D("Task %s queued until init()", entry.name);
+    return DEFERRED;
+}
+
+bool Watchdog::cancelDeferredRegistration(TaskHandle_t task) {
+    uint32_t reserved = pendingState_.load(std::memory_order_acquire);
+    if (reserved & PENDING_CLOSED) {
         return false;
     }
+    bool cancelled = false;
+    for (size_t i = 0; i < reserved; i++) {
+        // Ready entries are only rewritten after being cancelled, so the handle is stable
+        PendingRegistration& entry = pending_[i];
+        uint8_t ready = PENDING_READY;
+        if (entry.state.load(std::memory_order_acquire) == PENDING_READY && entry.handle == task &&
+            entry.state.compare_exchange_strong(ready, PENDING_CANCELLED,
+                                                std::memory_order_relaxed)) {
+            cancelled = true;
+        }
+    }
+    return cancelled;
+}
+
+bool Watchdog::waitUntilInitialized() {
+    // init() closes the queue, registers its entries and only then sets
+    // initialized_; until it has, registry changes would race with it
+    while (!initialized_.load(std::memory_order_acquire)) {
+        if (!(pendingState_.load(std::memory_order_acquire) & PENDING_CLOSED)) {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+    return true;
+}
+
+void Watchdog::applyDeferredRegistrations() {
+    // From here on, registrations find the queue closed and wait for
+    // initialized_, then register directly
+    uint32_t reserved = pendingState_.fetch_or(PENDING_CLOSED, std::memory_order_acq_rel) &
+                        ~PENDING_CLOSED;
+    TaskRegistration tasks[PENDING_REGISTRATIONS];
+    size_t count = 0;
+    for (size_t i = 0; i < reserved; i++) {
+        PendingRegistration& entry = pending_[i];
+        uint8_t state = entry.state.load(std::memory_order_acquire);
+        while (true) {
+            // The task that reserved or reused the entry may still be filling it
+            while (state == PENDING_EMPTY) {
+                vTaskDelay(1);
+                state = entry.state.load(std::memory_order_acquire);
+            }
+            // Taking a ready entry races with a late cancellation, and
+            // freeing a cancelled one with its reuse; one side wins each
+            if (entry.state.compare_exchange_strong(state, PENDING_EMPTY,
+                                                    std::memory_order_acquire)) {
+                break;
+            }
+        }
+        if (state == PENDING_READY) {
+            tasks[count++] = {entry.handle, entry.name[0] ? entry.name : nullptr,
+                              entry.feedIntervalMs, entry.isCritical};
+        }
+    }
+    
+    // Handles are used as queued: a task deleted without unregistering
+    // leaves a dangling one, which is why queued tasks must unregister
+    // before they are deleted
+    if (count > 0) {
+        registerTaskBatch(tasks, count);
+    }
+}
+#endif
+
+Watchdog::FeedHandle Watchdog::registerCurrentTaskWithHandle(const char* taskName, bool isCritical,
+                                                             uint32_t feedIntervalMs) noexcept {
+    size_t slot = registerCurrentTaskSlot(taskName, isCritical, feedIntervalMs);
+    if (slot == NO_SLOT) {
+        return FeedHandle();
+    }
+    return FeedHandle(this, slot, slotGenerations_[slot].load(std::memory_order_relaxed),
+                      xTaskGetCurrentTaskHandle());
+}
+
+size_t Watchdog::registerCurrentTaskSlot(const char* taskName, bool isCritical,
+                                         uint32_t feedIntervalMs) {
+    if (!waitUntilInitialized()) {
+        WDOG_LOG_E("Watchdog not initialized");
+        return NO_SLOT;
+    }
     
     TaskHandle_t currentTask = xTaskGetCurrentTaskHandle();
     if (!currentTask) {
         WDOG_LOG_E("Failed to get current task handle");
-        return false;
+        return NO_SLOT;
     }
     
+    bool addedToTwdt = false;
+    if (!subscribeToTwdt(currentTask, taskName, addedToTwdt)) {
+        return NO_SLOT;
+    }
+    
+    // Add to our internal tracking. Only the task itself registers its own
+    // handle, so the duplicate check and the claim need no lock.
+    size_t existing = findTaskByHandle(currentTask);
+    if (existing != NO_SLOT) {
+        cacheCurrentTask(existing);
+        WDOG_LOG_W("Task %s already registered", taskName);
+        return existing;
+    }
+    
+    // Either found subscribed or added above
+    size_t slot = claimSlot(currentTask, taskName, isCritical, feedIntervalMs, true);
+    if (slot == NO_SLOT) {
+        WDOG_LOG_E("Cannot register task %s", taskName);
+        if (addedToTwdt) {
+            esp_task_wdt_delete(currentTask);
+        }
+        return NO_SLOT;
+    }
+    cacheCurrentTask(slot);
+    
+    // Immediately feed to prevent early timeout
+    esp_task_wdt_reset();
+    
+    WDOG_LOG_I("Task %s registered (critical=%d, interval=%lums)", 
+             taskName, isCritical, slotIntervalMs(slot));
+    return slot;
+}
+
+bool Watchdog::subscribeToTwdt(TaskHandle_t task, const char* name, bool& added) {
     // Check if task is already registered with ESP-IDF watchdog
-    esp_err_t status = esp_task_wdt_status(currentTask);
+    added = false;
+    esp_err_t status = esp_task_wdt_status(task);
     if (status == ESP_OK) {
         // Already registered with ESP-IDF watchdog
-        WDOG_LOG_D("Task %s already registered with ESP-IDF watchdog", taskName);
+        WDOG_LOG_D("Task %s already registered with ESP-IDF watchdog", name);
     } else if (status == ESP_ERR_NOT_FOUND) {
         // Not registered, add it
-        esp_err_t err = esp_task_wdt_add(currentTask);
+        esp_err_t err = esp_task_wdt_add(task);
         if (err != ESP_OK) {
-            WDOG_LOG_E("Failed to add task %s to watchdog: 0x%x", taskName, err);
+            WDOG_LOG_E("Failed to add task %s to watchdog: 0x%x", name, err);
             return false;
         }
-        WDOG_LOG_D("Task %s added to ESP-IDF watchdog", taskName);
+        added = true;
+        WDOG_LOG_D("Task %s added to ESP-IDF watchdog", name);
     } else {
-        WDOG_LOG_E("Failed to check watchdog status for task %s: 0x%x", taskName, status);
+        WDOG_LOG_E("Failed to check watchdog status for task %s: 0x%x", name, status);
         return false;
     }
+    return true;
+}
+
+bool Watchdog::bindStaticTask(size_t index) noexcept {
+    return bindStaticSlot(index) != NO_SLOT;
+}
+
+Watchdog::FeedHandle Watchdog::bindStaticTaskWithHandle(size_t index) noexcept {
+    size_t slot = bindStaticSlot(index);
+    if (slot == NO_SLOT) {
+        return FeedHandle();
+    }
+    return FeedHandle(this, slot, slotGenerations_[slot].load(std::memory_order_relaxed),
+                      xTaskGetCurrentTaskHandle());
+}
+
+size_t Watchdog::bindStaticSlot(size_t index) {
+    if (!waitUntilInitialized()) {
+        WDOG_LOG_E("Watchdog not initialized");
+        return NO_SLOT;
+    }
+    if (index >= staticTaskCount_) {
+        WDOG_LOG_E("No static task %u", (unsigned)index);
+        return NO_SLOT;
+    }
     
-    // Add to our internal tracking
-    if (xSemaphoreTake(taskListMutex_, portMAX_DELAY) == pdTRUE) {
-        // Check if already registered
-        TaskInfo* existing = findTaskByHandle(currentTask);
-        if (existing) {
-            WDOG_LOG_W("Task %s already registered", existing->name);
-            xSemaphoreGive(taskListMutex_);
-            return true;
+    TaskHandle_t currentTask = xTaskGetCurrentTaskHandle();
+    const char* name = slotName(index);
+    TaskHandle_t bound = slotHandles_[index].load(std::memory_order_acquire);
+    if (bound) {
+        if (bound != currentTask) {
+            WDOG_LOG_E("Static task %s is bound to another task", name);
+            return NO_SLOT;
         }
-        
-        // Add new task
-        TaskInfo info;
-        info.handle = currentTask;
-        strncpy(info.name, taskName, MAX_TASK_NAME_LEN - 1);
-        info.lastFeedTime = xTaskGetTickCount();
-        info.feedIntervalMs = (feedIntervalMs > 0) ? feedIntervalMs : (timeoutMs_ / 5);
-        info.isCritical = isCritical;
-        
-        registeredTasks_.push_back(info);
+        cacheCurrentTask(index);
+        WDOG_LOG_W("Task %s already registered", name);
+        return index;
+    }
+    // A task has one slot: it may not also take a static one
+    size_t existing = findTaskByHandle(currentTask);
+    if (existing != NO_SLOT) {
+        WDOG_LOG_E("Cannot bind static task %s: task already registered as %s", name,
+                 slotName(existing));
+        return NO_SLOT;
+    }
+    
+    bool addedToTwdt = false;
+    if (!subscribeToTwdt(currentTask, name, addedToTwdt)) {
+        return NO_SLOT;
+    }
+    
+    // Two tasks may bind the same index at once; only one claims it. The
+    // slot is not indexed yet and not SLOT_ACTIVE, so neither lookups nor
+    // the health pass see it before its state is set below.
+    TaskHandle_t unbound = nullptr;
+    if (!slotHandles_[index].compare_exchange_strong(unbound, currentTask,
+                                                     std::memory_order_acq_rel)) {
+        WDOG_LOG_E("Static task %s is bound to another task", name);
+        if (addedToTwdt) {
+            esp_task_wdt_delete(currentTask);
+        }
+        return NO_SLOT;
+    }
+    
+    // Name, interval and grace period were stored by init(); only the
+    // state of this run is set before activating the slot
+    slotDetails_[index].missedFeeds.store(0, std::memory_order_relaxed);
+    coalescedFeeds(index).store(0, std::memory_order_relaxed);
+    updateFeedTime(index, xTaskGetTickCount());
+    slotFlags_[index].store(SLOT_RESERVED | SLOT_ACTIVE | SLOT_TWDT, std::memory_order_release);
+    registeredCount_.fetch_add(1, std::memory_order_relaxed);
+    
+    if (lockRegistry(portMAX_DELAY)) {
+        indexSlot(index);
+        publishSnapshot();
+        xSemaphoreGive(taskListMutex_);
+    }
+    cacheCurrentTask(index);
+    esp_task_wdt_reset();
+    
+    WDOG_LOG_I("Task %s bound to static slot %u", name, (unsigned)index);
+    return index;
+}
+
+size_t Watchdog::claimSlot(TaskHandle_t owner, const char* name, bool isCritical,
+                          uint32_t feedIntervalMs, bool twdtSubscribed) {
+    size_t slot = fillFreeSlot(owner, name, isCritical, feedIntervalMs, twdtSubscribed);
+    if (slot != NO_SLOT && lockRegistry(portMAX_DELAY)) {
+        indexSlot(slot);
+        publishSnapshot();
         xSemaphoreGive(taskListMutex_);
+    }
+    return slot;
+}
+
+size_t Watchdog::fillFreeSlot(TaskHandle_t owner, const char* name, bool isCritical,
+                              uint32_t feedIntervalMs, bool twdtSubscribed) {
+    // A popped slot belongs to us alone; fill it while its handle is
+    // still nullptr and it is therefore invisible to readers
+    size_t slot = popFreeSlot(shardFor(owner));
+    if (slot == NO_SLOT) {
+        WDOG_LOG_E("All %u slots in use", (unsigned)MAX_TASKS);
+        return NO_SLOT;
+    }
+    if (!setSlotDetails(slot, name, isCritical,
+                        (feedIntervalMs > 0) ? feedIntervalMs : (getTimeoutMs() / 5))) {
+        pushFreeSlot(slot);
+        return NO_SLOT;
+    }
+    slotDetails_[slot].missedFeeds.store(0, std::memory_order_relaxed);
+    coalescedFeeds(slot).store(0, std::memory_order_relaxed);
+    
+    // Enforce the interval as stored, which may have been rounded
+    graceTicks_[slot] = pdMS_TO_TICKS(slotIntervalMs(slot) * 2);
+    updateFeedTime(slot, xTaskGetTickCount());
+    uint8_t flags = SLOT_ACTIVE;
+    if (twdtSubscribed) {
+        flags |= SLOT_TWDT;
+    }
+    if (!owner) {
+        flags |= SLOT_HEARTBEAT;
+    }
+    slotFlags_[slot].store(flags, std::memory_order_release);
+    
+    // Publish last: lock-free readers only look at slots with a handle
+    TaskHandle_t handle = owner ? owner : heartbeatHandle(slot);
+    slotHandles_[slot].store(handle, std::memory_order_release);
+    registeredCount_.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+size_t Watchdog::registerTasks(const TaskRegistration* tasks, size_t count) noexcept {
+    if (!waitUntilInitialized()) {
+        WDOG_LOG_E("Watchdog not initialized");
+        return 0;
+    }
+    return registerTaskBatch(tasks, count);
+}
+
+size_t Watchdog::registerTaskBatch(const TaskRegistration* tasks, size_t count) {
+    if (!tasks) {
+        return 0;
+    }
+    
+    // Claim and publish slots first; the lookup indexes and the snapshot
+    // are then updated in one registry transaction per REGISTER_BATCH slots
+    uint16_t claimed[REGISTER_BATCH];
+    size_t claimedCount = 0;
+    size_t added = 0;
+    size_t registered = 0;
+    TaskHandle_t caller = xTaskGetCurrentTaskHandle();
+    bool resetCaller = false;
+    for (size_t i = 0; i < count; i++) {
+        const TaskRegistration& task = tasks[i];
+        if (!task.handle) {
+            WDOG_LOG_E("Task %u: invalid task handle", (unsigned)i);
+            continue;
+        }
+        const char* name = task.name ? task.name : pcTaskGetName(task.handle);
         
-        // Immediately feed to prevent early timeout
-        esp_task_wdt_reset();
+        // Entries claimed since the last transaction are published but not yet indexed
+        bool duplicate = findTaskByHandle(task.handle) != NO_SLOT;
+        for (size_t j = 0; j < claimedCount && !duplicate; j++) {
+            duplicate = slotHandles_[claimed[j]].load(std::memory_order_relaxed) == task.handle;
+        }
+        if (duplicate) {
+            WDOG_LOG_D("Task %s already registered", name);
+            registered++;
+            continue;
+        }
         
-        WDOG_LOG_I("Task %s registered (critical=%d, interval=%lums)", 
-                 taskName, isCritical, info.feedIntervalMs);
-        return true;
+        bool addedToTwdt = false;
+        if (!subscribeToTwdt(task.handle, name, addedToTwdt)) {
+            continue;
+        }
+        size_t slot = fillFreeSlot(task.handle, name, task.isCritical, task.feedIntervalMs, true);
+        if (slot == NO_SLOT) {
+            WDOG_LOG_E("Cannot register task %s", name);
+            if (addedToTwdt) {
+                esp_task_wdt_delete(task.handle);
+            }
+            continue;
+        }
+        // feed() takes a task without a cache entry to be unregistered
+        cacheTaskSlot(task.handle, slot);
+        claimed[claimedCount++] = static_cast<uint16_t>(slot);
+        added++;
+        registered++;
+        resetCaller = resetCaller || task.handle == caller;
+        if (claimedCount == REGISTER_BATCH) {
+            indexClaimedSlots(claimed, claimedCount);
+            claimedCount = 0;
+        }
     }
     
-    return false;
+    // A new TWDT entry has not been reset yet, and the TWDT restarts its one
+    // shared timer only once every entry has been. esp_task_wdt_reset() only
+    // acts for the calling task, so it is done for the caller if it was in
+    // the batch; every other task must feed before the current period ends.
+    if (resetCaller) {
+        esp_task_wdt_reset();
+    }
+    
+    indexClaimedSlots(claimed, claimedCount);
+    
+    WDOG_LOG_I("Registered %u of %u tasks (%u new)", (unsigned)registered, (unsigned)count,
+             (unsigned)added);
+    return registered;
+}
+
+void Watchdog::indexClaimedSlots(const uint16_t* slots, size_t count) {
+    if (count > 0 && lockRegistry(portMAX_DELAY)) {
+        for (size_t i = 0; i < count; i++) {
+            indexSlot(slots[i]);
+        }
+        publishSnapshot();
+        xSemaphoreGive(taskListMutex_);
+    }
+}
+
+size_t Watchdog::unregisterTasks(const TaskHandle_t* handles, size_t count) noexcept {
+    if (!handles) {
+        return 0;
+    }
+    
+    // TWDT calls stay outside the lock, as in removeTask()
+    size_t failed = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!handles[i]) {
+            continue;
+        }
+        esp_err_t err = esp_task_wdt_delete(handles[i]);
+        if (err != ESP_OK && err != ESP_ERR_NOT_FOUND) {
+            WDOG_LOG_E("Failed to remove task from watchdog: 0x%x", err);
+            failed++;
+        }
+    }
+    
+    size_t removed = 0;
+    if (lockRegistry(portMAX_DELAY)) {
+        for (size_t i = 0; i < count; i++) {
+            size_t slot = handles[i] ? findTaskByHandle(handles[i]) : NO_SLOT;
+            if (slot != NO_SLOT) {
+                releaseSlot(slot, nullptr);
+                removed++;
+            }
+        }
+        if (removed > 0) {
+            publishSnapshot();
+        }
+        xSemaphoreGive(taskListMutex_);
+    }
+    
+    WDOG_LOG_I("Unregistered %u of %u tasks", (unsigned)removed, (unsigned)count);
+    if (failed > 0) {
+        WDOG_LOG_W("%u tasks could not be removed from the TWDT", (unsigned)failed);
+    }
+    return removed;
+}
+
+#ifdef WATCHDOG_COMPACT_TASKINFO
+bool Watchdog::setSlotDetails(size_t slot, const char* name, bool isCritical,
+                              uint32_t feedIntervalMs) {
+    // A longer interval would saturate the 16-bit field and be enforced
+    // shorter than requested
+    if (feedIntervalMs > MAX_FEED_INTERVAL_MS) {
+        WDOG_LOG_E("Feed interval %lums of %s exceeds the %lums maximum", feedIntervalMs, name,
+                 (unsigned long)MAX_FEED_INTERVAL_MS);
+        return false;
+    }
+    
+    if (!lockRegistry(portMAX_DELAY)) {
+        WDOG_LOG_E("Cannot store name of %s: registry mutex not available", name);
+        return false;
+    }
+    size_t nameRef = internName(name);
+    xSemaphoreGive(taskListMutex_);
+    if (nameRef == NAME_TABLE_SIZE) {
+        WDOG_LOG_E("All %u name table entries in use", (unsigned)NAME_TABLE_SIZE);
+        return false;
+    }
+    
+    SlotDetails& details = slotDetails_[slot];
+    details.nameRef = static_cast<uint16_t>(nameRef);
+    details.isCritical = isCritical ? 1 : 0;
+    uint32_t units = (feedIntervalMs + WATCHDOG_INTERVAL_UNIT_MS - 1) / WATCHDOG_INTERVAL_UNIT_MS;
+    details.feedInterval = static_cast<uint16_t>(units);
+    return true;
+}
+
+size_t Watchdog::internName(const char* name) {
+    size_t freeEntry = NAME_TABLE_SIZE;
+    for (size_t i = 0; i < NAME_TABLE_SIZE; i++) {
+        if (names_[i].refs == 0) {
+            if (freeEntry == NAME_TABLE_SIZE) {
+                freeEntry = i;
+            }
+        } else if (strncmp(names_[i].name, name, MAX_TASK_NAME_LEN - 1) == 0) {
+            names_[i].refs++;
+            return i;
+        }
+    }
+    if (freeEntry != NAME_TABLE_SIZE) {
+        NameEntry& entry = names_[freeEntry];
+        memset(entry.name, 0, MAX_TASK_NAME_LEN);
+        strncpy(entry.name, name, MAX_TASK_NAME_LEN - 1);
+        entry.refs = 1;
+    }
+    return freeEntry;
+}
+#else
+bool Watchdog::setSlotDetails(size_t slot, const char* name, bool isCritical,
+                              uint32_t feedIntervalMs) {
+    SlotDetails& details = slotDetails_[slot];
+    memset(details.name, 0, MAX_TASK_NAME_LEN);
+    strncpy(details.name, name, MAX_TASK_NAME_LEN - 1);
+    details.nameHash = WatchdogIndex::hashName(details.name, MAX_TASK_NAME_LEN);
+    details.feedIntervalMs = feedIntervalMs;
+    details.isCritical = isCritical;
+    return true;
+}
+#endif
+
+void Watchdog::indexSlot(size_t slot) {
+    // A concurrent deinit() may already have released the slot
+    TaskHandle_t handle = slotHandles_[slot].load(std::memory_order_relaxed);
+    if (!handle) {
+        return;
+    }
+    if (!(slotFlags_[slot].load(std::memory_order_relaxed) & SLOT_HEARTBEAT)) {
+        handleIndex_.insert(WatchdogIndex::hashPointer(handle), static_cast<uint16_t>(slot));
+    }
+    nameIndex_.insert(slotNameHash(slot), static_cast<uint16_t>(slot));
+}
+
+void Watchdog::unindexSlot(size_t slot) {
+    if (!(slotFlags_[slot].load(std::memory_order_relaxed) & SLOT_HEARTBEAT)) {
+        TaskHandle_t handle = slotHandles_[slot].load(std::memory_order_relaxed);
+        handleIndex_.remove(WatchdogIndex::hashPointer(handle), static_cast<uint16_t>(slot),
+                            [this](uint16_t other) {
+                                return WatchdogIndex::hashPointer(
+                                    slotHandles_[other].load(std::memory_order_relaxed));
+                            });
+    }
+    nameIndex_.remove(slotNameHash(slot), static_cast<uint16_t>(slot),
+                      [this](uint16_t other) { return slotNameHash(other); });
+}
+
+void Watchdog::releaseSlot(size_t slot, char* removedName) {
+    if (removedName) {
+        memcpy(removedName, slotName(slot), MAX_TASK_NAME_LEN);
+    }
+    unindexSlot(slot);
+    // A static task's slot keeps its details and stays reserved for it
+    bool reserved = slot < staticTaskCount_;
+    // The shard's health pass must not see the slot half released
+    size_t shard = shardOf(slot);
+    bool locked = lockShard(shard, portMAX_DELAY);
+    beginSlotWrite(slot);
+#ifdef WATCHDOG_COMPACT_TASKINFO
+    if (!reserved) {
+        names_[slotDetails_[slot].nameRef].refs--;
+    }
+#endif
+    // Clear the flags first so the health scan stops looking at the slot,
+    // and retire outstanding FeedHandles and heartbeat ids before the
+    // slot can be reused
+    slotFlags_[slot].store(reserved ? SLOT_RESERVED : 0, std::memory_order_relaxed);
+    setUnhealthy(slot, false);
+    slotGenerations_[slot].fetch_add(1, std::memory_order_relaxed);
+    slotHandles_[slot].store(nullptr, std::memory_order_release);
+    endSlotWrite(slot);
+    if (locked) {
+        xSemaphoreGive(shards_[shard].healthMutex);
+    }
+    registeredCount_.fetch_sub(1, std::memory_order_relaxed);
+    if (!reserved) {
+        pushFreeSlot(slot);
+    }
+}
+
+size_t Watchdog::releaseAllSlots() {
+    // Every shard at once, so no health pass sees a partly cleared table
+    bool locked[SHARDS];
+    for (size_t shard = 0; shard < SHARDS; shard++) {
+        locked[shard] = lockShard(shard, portMAX_DELAY);
+    }
+    size_t released = 0;
+    for (size_t slot = 0; slot < MAX_TASKS; slot++) {
+        if (!slotHandles_[slot].load(std::memory_order_relaxed)) {
+            continue;
+        }
+        bool reserved = slot < staticTaskCount_;
+        beginSlotWrite(slot);
+#ifdef WATCHDOG_COMPACT_TASKINFO
+        if (!reserved) {
+            names_[slotDetails_[slot].nameRef].refs--;
+        }
+#endif
+        slotFlags_[slot].store(reserved ? SLOT_RESERVED : 0, std::memory_order_relaxed);
+        slotGenerations_[slot].fetch_add(1, std::memory_order_relaxed);
+        slotHandles_[slot].store(nullptr, std::memory_order_release);
+        endSlotWrite(slot);
+        released++;
+    }
+    for (size_t i = 0; i < HEALTH_WORDS; i++) {
+        unhealthyMask_[i].store(0, std::memory_order_relaxed);
+    }
+    for (size_t shard = 0; shard < SHARDS; shard++) {
+        if (locked[shard]) {
+            xSemaphoreGive(shards_[shard].healthMutex);
+        }
+    }
+    // Whole tables instead of one backward-shift deletion per slot
+    handleIndex_.clear();
+    nameIndex_.clear();
+    registeredCount_.fetch_sub(released, std::memory_order_relaxed);
+    return released;
+}
+
+size_t Watchdog::popFreeSlot(size_t shard) {
+    // Own shard first; a full shard borrows from the next one
+    for (size_t n = 0; n < SHARDS; n++) {
+        std::atomic<uint32_t>& freeHead = shards_[(shard + n) % SHARDS].freeHead;
+        uint32_t head = freeHead.load(std::memory_order_acquire);
+        while (true) {
+            uint16_t slot = static_cast<uint16_t>(head & 0xFFFF);
+            if (slot == FREE_END) {
+                break;
+            }
+            // May read a stale link if another claimer wins the race; the
+            // counter in the head then makes the CAS below fail
+            uint16_t next = nextFree_[slot].load(std::memory_order_relaxed);
+            uint32_t newHead = ((head + 0x10000) & 0xFFFF0000) | next;
+            if (freeHead.compare_exchange_weak(head, newHead, std::memory_order_acquire,
+                                               std::memory_order_acquire)) {
+                return slot;
+            }
+        }
+    }
+    return NO_SLOT;
+}
+
+void Watchdog::pushFreeSlot(size_t slot) {
+    std::atomic<uint32_t>& freeHead = shards_[shardOf(slot)].freeHead;
+    uint32_t head = freeHead.load(std::memory_order_relaxed);
+    uint32_t newHead;
+    do {
+        nextFree_[slot].store(static_cast<uint16_t>(head & 0xFFFF), std::memory_order_relaxed);
+        newHead = ((head + 0x10000) & 0xFFFF0000) | static_cast<uint32_t>(slot);
+    } while (!freeHead.compare_exchange_weak(head, newHead, std::memory_order_release,
+                                             std::memory_order_relaxed));
+}
+
+size_t Watchdog::shardFor(TaskHandle_t owner) {
+#if WATCHDOG_CORE_SHARDS > 1
+    BaseType_t core = owner ? xTaskGetAffinity(owner) : tskNO_AFFINITY;
+    if (core < 0 || static_cast<size_t>(core) >= SHARDS) {
+        core = xPortGetCoreID();
+    }
+    return static_cast<size_t>(core) % SHARDS;
+#else
+    (void)owner;
+    return 0;
+#endif
+}
+
+Watchdog::HeartbeatId Watchdog::registerHeartbeat(const char* name, uint32_t feedIntervalMs) noexcept {
+    if (!waitUntilInitialized()) {
+        WDOG_LOG_E("Watchdog not initialized");
+        return INVALID_HEARTBEAT;
+    }
+    if (!name) {
+        WDOG_LOG_E("Heartbeat needs a name");
+        return INVALID_HEARTBEAT;
+    }
+    
+    size_t slot = claimSlot(nullptr, name, false, feedIntervalMs, false);
+    if (slot == NO_SLOT) {
+        WDOG_LOG_E("Cannot register heartbeat %s", name);
+        return INVALID_HEARTBEAT;
+    }
+    
+    WDOG_LOG_I("Heartbeat %s registered (interval=%lums)", name,
+             slotIntervalMs(slot));
+    return (static_cast<HeartbeatId>(slotGenerations_[slot].load(std::memory_order_relaxed)) << 16) |
+           static_cast<HeartbeatId>(slot);
+}
+
+bool Watchdog::unregisterHeartbeat(HeartbeatId id) noexcept {
+    char removedName[MAX_TASK_NAME_LEN] = {0};
+    bool found = false;
+    if (lockRegistry(portMAX_DELAY)) {
+        size_t slot = findHeartbeat(id);
+        if (slot != NO_SLOT) {
+            releaseSlot(slot, removedName);
+            publishSnapshot();
+            found = true;
+        }
+        xSemaphoreGive(taskListMutex_);
+    }
+    
+    if (!found) {
+        WDOG_LOG_W("Heartbeat %08lx not registered", (unsigned long)id);
+        return false;
+    }
+    WDOG_LOG_I("Heartbeat %s unregistered", removedName);
+    return true;
+}
+
+bool WATCHDOG_IRAM_ATTR Watchdog::feedHeartbeat(HeartbeatId id) noexcept {
+    size_t slot = findHeartbeat(id);
+    if (slot == NO_SLOT) {
+        return false;
+    }
+    return storeDeadline(slot, heartbeatHandle(slot), static_cast<uint16_t>(id >> 16),
+                         xTaskGetTickCount());
+}
+
+bool WATCHDOG_IRAM_ATTR Watchdog::feedFromISR(HeartbeatId id) noexcept {
+    size_t slot = findHeartbeat(id);
+    if (slot == NO_SLOT) {
+        return false;
+    }
+    return storeDeadline(slot, heartbeatHandle(slot), static_cast<uint16_t>(id >> 16),
+                         xTaskGetTickCountFromISR());
 }
 
 bool Watchdog::unregisterCurrentTask() noexcept {
@@ -126,7 +907,19 @@ bool Watchdog::unregisterCurrentTask() noexcept {
         return false;
     }
     
-    return unregisterTaskByHandle(currentTask);
+    if (!initialized_.load(std::memory_order_acquire)) {
+        // Not applied yet: withdrawing the queued registration is enough
+        if (cancelDeferredRegistration(currentTask)) {
+            return true;
+        }
+        // init() may be registering the entry right now; let it finish,
+        // then remove the task as usual
+        waitUntilInitialized();
+    }
+    
+    size_t cached = findCurrentTask(currentTask);
+    cacheCurrentTask(NO_SLOT);
+    return removeTask(currentTask, cached, nullptr);
 }
 
 bool Watchdog::unregisterTaskByHandle(TaskHandle_t taskHandle, const char* taskName) noexcept {
@@ -135,6 +928,12 @@ bool Watchdog::unregisterTaskByHandle(TaskHandle_t taskHandle, const char* taskN
         return false;
     }
     
+    // The task's own TLS cache is left alone: the task may already be
+    // deleted, and a stale cache entry fails validation in findCurrentTask()
+    return removeTask(taskHandle, NO_SLOT, taskName);
+}
+
+bool Watchdog::removeTask(TaskHandle_t taskHandle, size_t hint, const char* taskName) {
     // Remove from ESP-IDF watchdog
     esp_err_t err = esp_task_wdt_delete(taskHandle);
     if (err != ESP_OK && err != ESP_ERR_NOT_FOUND) {
@@ -143,136 +942,394 @@ bool Watchdog::unregisterTaskByHandle(TaskHandle_t taskHandle, const char* taskN
     }
     
     // Remove from internal tracking
-    if (xSemaphoreTake(taskListMutex_, portMAX_DELAY) == pdTRUE) {
-        auto it = std::remove_if(registeredTasks_.begin(), registeredTasks_.end(),
-            [taskHandle](const TaskInfo& info) {
-                return info.handle == taskHandle;
-            });
+    char removedName[MAX_TASK_NAME_LEN] = {0};
+    bool found = false;
+    if (lockRegistry(portMAX_DELAY)) {
+        size_t slot = (hint != NO_SLOT && slotHandles_[hint].load() == taskHandle) ?
+                      hint : findTaskByHandle(taskHandle);
         
-        if (it != registeredTasks_.end()) {
-            // Use provided name or lookup name for logging
-            const char* logName = taskName ? taskName : it->name;
-            WDOG_LOG_I("Task %s unregistered", logName);
-            registeredTasks_.erase(it, registeredTasks_.end());
-        } else if (taskName) {
-            WDOG_LOG_W("Task %s not found in registered list", taskName);
+        if (slot != NO_SLOT) {
+            releaseSlot(slot, removedName);
+            publishSnapshot();
+            found = true;
         }
         
         xSemaphoreGive(taskListMutex_);
     }
     
+    // Log outside the lock
+    if (found) {
+        // Use provided name or lookup name for logging
+        WDOG_LOG_I("Task %s unregistered", taskName ? taskName : removedName);
+    } else if (taskName) {
+        WDOG_LOG_W("Task %s not found in registered list", taskName);
+    }
+    
     return true;
 }
 
-bool Watchdog::feed() noexcept {
-    TaskHandle_t currentTask = xTaskGetCurrentTaskHandle();
-    if (!currentTask) {
+#ifdef WATCHDOG_FEED_IN_IRAM
+bool WATCHDOG_IRAM_ATTR Watchdog::feed() noexcept {
+    return feedFast();
+}
+#endif
+
+bool WATCHDOG_IRAM_ATTR Watchdog::feedSlow(TaskHandle_t currentTask) noexcept {
+    // Update internal tracking if task is registered with us. Slots never
+    // move and only the owning task feeds its slot, so no lock is needed.
+    size_t slot = findCurrentTask(currentTask);
+    if (slot == NO_SLOT) {
+        // Not registered with us, but the task may still be subscribed to the
+        // TWDT directly (loopTask, or esp_task_wdt_add() by the application).
+        // Only reset it if it is: this avoids the noisy ESP-IDF error log
+        // "esp_task_wdt_reset(705): task not found".
+        // NOTE: We intentionally do NOT auto-register tasks here.
+        // Tasks must explicitly call registerCurrentTask() to opt-in to watchdog monitoring.
+#ifdef WATCHDOG_FEED_IN_IRAM
+        // Both calls are in flash; skip them while the cache is off
+        if (!spi_flash_cache_enabled()) {
+            return true;
+        }
+#endif
+        if (esp_task_wdt_status(currentTask) == ESP_OK) {
+            esp_task_wdt_reset();
+        }
+        return true;
+    }
+    return feedSlot(slot, currentTask, slotGenerations_[slot].load(std::memory_order_acquire));
+}
+
+bool Watchdog::setFeedCoalescing(uint32_t windowMs) noexcept {
+    uint32_t timeoutMs = getTimeoutMs();
+    if (windowMs >= timeoutMs / 5) {
+        WDOG_LOG_E("Coalescing window %lums too large for %lums timeout", windowMs, timeoutMs);
         return false;
     }
+    
+    coalesceWindowTicks_.store(pdMS_TO_TICKS(windowMs), std::memory_order_relaxed);
+    WDOG_LOG_D("Feed coalescing window set to %lums", windowMs);
+    return true;
+}
 
-    // Update internal tracking if task is registered with us
-    if (xSemaphoreTake(taskListMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
-        TaskInfo* info = findTaskByHandle(currentTask);
-        if (info) {
-            info->lastFeedTime = xTaskGetTickCount();
-            info->missedFeeds = 0;
+uint32_t Watchdog::getCoalescedFeedCount() const noexcept {
+    uint32_t total = 0;
+    for (size_t i = 0; i < MAX_TASKS; i++) {
+        if (slotHandles_[i].load(std::memory_order_acquire)) {
+            total += coalescedFeeds(i).load(std::memory_order_relaxed);
         }
-        xSemaphoreGive(taskListMutex_);
     }
+    return total;
+}
 
-    // Only call esp_task_wdt_reset() if task is registered with hardware watchdog
-    // This avoids the noisy ESP-IDF error log: "esp_task_wdt_reset(705): task not found"
-    // NOTE: We intentionally do NOT auto-register tasks here.
-    // Tasks must explicitly call registerCurrentTask() to opt-in to watchdog monitoring.
-    esp_err_t status = esp_task_wdt_status(currentTask);
-    if (status == ESP_OK) {
-        // Task is registered, feed the watchdog
-        esp_task_wdt_reset();
+#ifdef WATCHDOG_REGISTRY_SNAPSHOTS
+bool Watchdog::getTaskInfo(const char* taskName, TaskInfo& info) const {
+    if (!taskName) return false;
+    
+    uint8_t token = snapshots_.enter();
+    const RegistrySnapshot& snapshot = snapshots_.get(token);
+    size_t slot = findSnapshotEntry(snapshot, taskName);
+    bool found = slot != NO_SLOT && readSnapshotEntry(snapshot, slot, info);
+    snapshots_.leave(token);
+    return found;
+}
+
+void Watchdog::publishSnapshot() {
+    // Registration is rare, so the whole membership is copied each time
+    RegistrySnapshot& next = snapshots_.beginUpdate([]() { vTaskDelay(1); });
+    memset(next.byName, 0, sizeof(next.byName));
+    for (size_t i = 0; i < MAX_TASKS; i++) {
+        SnapshotEntry& entry = next.entries[i];
+        entry.handle = slotHandles_[i].load(std::memory_order_acquire);
+        if (!entry.handle) {
+            continue;
+        }
+        memcpy(entry.name, slotName(i), MAX_TASK_NAME_LEN);
+        entry.generation = slotGenerations_[i].load(std::memory_order_relaxed);
+        
+        size_t bucket = slotNameHash(i) & (INDEX_BUCKETS - 1);
+        while (next.byName[bucket] != 0) {
+            bucket = (bucket + 1) & (INDEX_BUCKETS - 1);
+        }
+        next.byName[bucket] = static_cast<uint16_t>(i + 1);
     }
-    // If not registered (ESP_ERR_NOT_FOUND), silently succeed - this is expected behavior
-    return true;
+    next.version = snapshots_.latest().version + 1;
+    snapshots_.publish();
 }
 
-size_t Watchdog::getRegisteredTaskCount() const noexcept {
-    size_t count = 0;
-    if (xSemaphoreTake(taskListMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
-        count = registeredTasks_.size();
-        xSemaphoreGive(taskListMutex_);
+size_t Watchdog::findSnapshotEntry(const RegistrySnapshot& snapshot, const char* name) const {
+    // The snapshot never changes while entered, so probing needs no retry
+    size_t bucket = WatchdogIndex::hashName(name, MAX_TASK_NAME_LEN) & (INDEX_BUCKETS - 1);
+    while (snapshot.byName[bucket] != 0) {
+        size_t slot = snapshot.byName[bucket] - 1;
+        if (strncmp(snapshot.entries[slot].name, name, MAX_TASK_NAME_LEN) == 0) {
+            return slot;
+        }
+        bucket = (bucket + 1) & (INDEX_BUCKETS - 1);
     }
-    return count;
+    return NO_SLOT;
 }
 
+bool Watchdog::readSnapshotEntry(const RegistrySnapshot& snapshot, size_t slot,
+                                 TaskInfo& info) const {
+    // The entry only says which registration to read; its fields are read
+    // live, and not at all if the slot has been released since
+    const SnapshotEntry& entry = snapshot.entries[slot];
+    return entry.handle && readSlot(slot, entry.generation, info);
+}
+#else
 bool Watchdog::getTaskInfo(const char* taskName, TaskInfo& info) const {
     if (!taskName) return false;
     
-    if (xSemaphoreTake(taskListMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
-        for (const auto& task : registeredTasks_) {
-            if (strncmp(task.name, taskName, MAX_TASK_NAME_LEN) == 0) {
-                info = task;
-                xSemaphoreGive(taskListMutex_);
-                return true;
-            }
+    // Only the lookup needs the mutex; the slot is copied after releasing
+    // it, and the generation tells whether it still holds this task
+    size_t slot = NO_SLOT;
+    uint16_t generation = 0;
+    if (lockRegistry(pdMS_TO_TICKS(10))) {
+        slot = findTaskByName(taskName);
+        if (slot != NO_SLOT) {
+            generation = slotGenerations_[slot].load(std::memory_order_relaxed);
         }
         xSemaphoreGive(taskListMutex_);
     }
-    return false;
+    return slot != NO_SLOT && readSlot(slot, generation, info);
+}
+#endif
+
+bool Watchdog::readSlot(size_t slot, uint16_t generation, TaskInfo& info) const {
+    typedef std::make_signed<TickType_t>::type SignedTick;
+    while (true) {
+        uint16_t sequence = slotSequences_[slot].load(std::memory_order_acquire);
+        if (sequence & 1) {
+            // The health pass or a release is rewriting the slot; let it finish
+            vTaskDelay(1);
+            continue;
+        }
+        
+        TaskHandle_t handle = slotHandles_[slot].load(std::memory_order_acquire);
+        uint8_t flags = slotFlags_[slot].load(std::memory_order_relaxed);
+        uint16_t current = slotGenerations_[slot].load(std::memory_order_relaxed);
+        // Written by feeders, which never wait: each is one word, read once
+        TickType_t deadline = deadlines_[slot].load(std::memory_order_acquire);
+        info.coalescedFeeds = coalescedFeeds(slot).load(std::memory_order_relaxed);
+        info.handle = handle;
+        memcpy(info.name, slotName(slot), MAX_TASK_NAME_LEN);
+        info.lastFeedTime = deadline - graceTicks_[slot];
+        info.feedIntervalMs = slotIntervalMs(slot);
+        // feed() leaves the counter alone; checkHealth() clears it on its
+        // next scan. Report the reset as soon as it is due.
+        bool overdue = (flags & SLOT_ACTIVE) &&
+                       static_cast<SignedTick>(xTaskGetTickCount() - deadline) > 0;
+        info.missedFeeds = overdue ? slotDetails_[slot].missedFeeds.load(std::memory_order_relaxed) : 0;
+        info.isCritical = slotDetails_[slot].isCritical != 0;
+        info.twdtSubscribed = (flags & SLOT_TWDT) != 0;
+        info.isHeartbeat = (flags & SLOT_HEARTBEAT) != 0;
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slotSequences_[slot].load(std::memory_order_relaxed) == sequence) {
+            return handle && current == generation;
+        }
+    }
+}
+
+void Watchdog::setUnhealthy(size_t slot, bool unhealthy) {
+    uint32_t bit = 1UL << (slot % 32);
+    if (unhealthy) {
+        unhealthyMask_[slot / 32].fetch_or(bit, std::memory_order_relaxed);
+    } else {
+        unhealthyMask_[slot / 32].fetch_and(~bit, std::memory_order_relaxed);
+    }
 }
 
 size_t Watchdog::checkHealth() noexcept {
     size_t unhealthyCount = 0;
-    TickType_t now = xTaskGetTickCount();
+    for (size_t shard = 0; shard < SHARDS; shard++) {
+        unhealthyCount += checkShardHealth(shard);
+    }
+    return unhealthyCount;
+}
+
+size_t Watchdog::checkCoreHealth(BaseType_t core) noexcept {
+    if (core < 0 || static_cast<size_t>(core) >= SHARDS) {
+        return 0;
+    }
+    return checkShardHealth(static_cast<size_t>(core));
+}
+
+size_t Watchdog::checkShardHealth(size_t shard) {
+    // Late tasks are copied out so that logging (slow UART writes) happens
+    // after the lock is released. Feeders never take the lock; this only
+    // keeps the critical section short for unregistration. The shard is
+    // scanned HEALTH_BATCH slots at a time, so the copies take a fixed
+    // amount of stack whatever WATCHDOG_MAX_TASKS is.
+    struct LateTask {
+        char name[MAX_TASK_NAME_LEN];
+        uint32_t sinceFeedMs;
+        uint32_t intervalMs;
+    };
+    LateTask late[HEALTH_BATCH];
+    uint8_t overdue[HEALTH_BATCH];
+    size_t unhealthyCount = 0;
+    size_t end = shardEnd(shard);
     
-    if (xSemaphoreTake(taskListMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
-        for (auto& task : registeredTasks_) {
-            TickType_t timeSinceLastFeed = now - task.lastFeedTime;
-            uint32_t timeSinceLastFeedMs = timeSinceLastFeed * portTICK_PERIOD_MS;
+    for (size_t begin = shardBegin(shard); begin < end; begin += HEALTH_BATCH) {
+        size_t count = end - begin;
+        if (count > HEALTH_BATCH) {
+            count = HEALTH_BATCH;
+        }
+        size_t lateCount = 0;
+        
+        if (lockShard(shard, pdMS_TO_TICKS(10))) {
+            // Sample the clock inside the lock so every slot of the batch is
+            // judged against the same instant and none is released mid-scan
+            TickType_t now = xTaskGetTickCount();
             
-            if (timeSinceLastFeedMs > task.feedIntervalMs * 2) {
-                task.missedFeeds++;
-                unhealthyCount++;
-                WDOG_LOG_W("Task %s hasn't fed watchdog for %lums (expected %lums)", 
-                         task.name, timeSinceLastFeedMs, task.feedIntervalMs);
+            // One pass over the batch's hot deadline and flag arrays; cold
+            // data is only touched for the few slots that need attention
+            WatchdogScan::markOverdue(&deadlines_[begin], &slotFlags_[begin], count, now,
+                                      SLOT_ACTIVE, overdue);
+            for (size_t n = 0; n < count; n++) {
+                size_t i = begin + n;
+                uint8_t flags = slotFlags_[i].load(std::memory_order_relaxed);
+                if (!overdue[n] && !(flags & SLOT_MISSED)) {
+                    continue;
+                }
+                SlotDetails& details = slotDetails_[i];
+                beginSlotWrite(i);
+                if (overdue[n]) {
+                    if (details.missedFeeds.load(std::memory_order_relaxed) != MISSED_FEEDS_MAX) {
+                        details.missedFeeds++;
+                    }
+                    if (!(flags & SLOT_MISSED)) {
+                        slotFlags_[i].store(flags | SLOT_MISSED, std::memory_order_relaxed);
+                        setUnhealthy(i, true);
+                    }
+                    endSlotWrite(i);
+                    LateTask& entry = late[lateCount++];
+                    TickType_t lastFeed = deadlines_[i].load(std::memory_order_acquire) - graceTicks_[i];
+                    memcpy(entry.name, slotName(i), MAX_TASK_NAME_LEN);
+                    entry.sinceFeedMs = (now - lastFeed) * portTICK_PERIOD_MS;
+                    entry.intervalMs = slotIntervalMs(i);
+                } else if (flags & SLOT_MISSED) {
+                    // Fed since the last scan
+                    details.missedFeeds.store(0, std::memory_order_relaxed);
+                    slotFlags_[i].store(flags & ~SLOT_MISSED, std::memory_order_relaxed);
+                    setUnhealthy(i, false);
+                    endSlotWrite(i);
+                }
             }
+            xSemaphoreGive(shards_[shard].healthMutex);
         }
-        xSemaphoreGive(taskListMutex_);
+        
+        for (size_t i = 0; i < lateCount; i++) {
+            WDOG_LOG_W("Task %s hasn't fed watchdog for %lums (expected %lums)", 
+                     late[i].name, late[i].sinceFeedMs, late[i].intervalMs);
+        }
+        unhealthyCount += lateCount;
     }
     
     return unhealthyCount;
 }
 
-Watchdog::TaskInfo* Watchdog::findTaskByHandle(TaskHandle_t handle) {
-    for (auto& task : registeredTasks_) {
-        if (task.handle == handle) {
-            return &task;
+size_t WATCHDOG_IRAM_ATTR Watchdog::findTaskByHandle(TaskHandle_t handle) {
+    uint16_t slot = SlotIndex::EMPTY;
+    bool consistent = handleIndex_.tryFind(WatchdogIndex::hashPointer(handle),
+        [this, handle](uint16_t candidate) {
+            return slotHandles_[candidate].load(std::memory_order_acquire) == handle;
+        }, slot);
+    if (!consistent) {
+        // Index changed under us; only possible without taskListMutex_
+        return scanSlots(handle);
+    }
+    return (slot == SlotIndex::EMPTY) ? NO_SLOT : slot;
+}
+
+size_t WATCHDOG_IRAM_ATTR Watchdog::scanSlots(TaskHandle_t handle) {
+    for (size_t i = 0; i < MAX_TASKS; i++) {
+        if (slotHandles_[i].load(std::memory_order_acquire) == handle) {
+            return i;
         }
     }
-    return nullptr;
+    return NO_SLOT;
+}
+
+size_t Watchdog::findTaskByName(const char* name) const {
+    uint16_t slot = nameIndex_.find(WatchdogIndex::hashName(name, MAX_TASK_NAME_LEN),
+        [this, name](uint16_t candidate) {
+            return slotHandles_[candidate].load(std::memory_order_acquire) &&
+                   strncmp(slotName(candidate), name, MAX_TASK_NAME_LEN) == 0;
+        });
+    return (slot == SlotIndex::EMPTY) ? NO_SLOT : slot;
+}
+
+size_t WATCHDOG_IRAM_ATTR Watchdog::findCurrentTask(TaskHandle_t currentTask) {
+#if WATCHDOG_TLS_INDEX >= 0
+    void* cached = pvTaskGetThreadLocalStoragePointer(nullptr, WATCHDOG_TLS_INDEX);
+    if (isSlot(cached)) {
+        // Slot may have been unregistered and reused by another task since
+        // it was cached; a handle mismatch means we are no longer registered
+        ZeroedAtomic<TaskHandle_t>* entry = static_cast<ZeroedAtomic<TaskHandle_t>*>(cached);
+        return (entry->load(std::memory_order_acquire) == currentTask) ?
+               static_cast<size_t>(entry - slotHandles_) : NO_SLOT;
+    }
+    if (!cached) {
+        return NO_SLOT;
+    }
+    // Index is in use by someone else - fall back to a search
+#endif
+    return findTaskByHandle(currentTask);
+}
+
+void Watchdog::cacheTaskSlot(TaskHandle_t task, size_t slot) {
+#if WATCHDOG_TLS_INDEX >= 0
+    // New tasks start with cleared TLS pointers, so a recycled task handle
+    // never inherits a cache entry. Never overwrite a foreign pointer.
+    void* cached = pvTaskGetThreadLocalStoragePointer(task, WATCHDOG_TLS_INDEX);
+    if (!cached || isSlot(cached)) {
+        void* entry = (slot == NO_SLOT) ? nullptr : &slotHandles_[slot];
+#if defined(configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS) && configTHREAD_LOCAL_STORAGE_DELETE_CALLBACKS
+        // Entries stay behind when a task is deleted without unregistering;
+        // make sure vTaskDelete() finds no callback to run on them
+        vTaskSetThreadLocalStoragePointerAndDelCallback(task, WATCHDOG_TLS_INDEX, entry, nullptr);
+#else
+        vTaskSetThreadLocalStoragePointer(task, WATCHDOG_TLS_INDEX, entry);
+#endif
+    }
+#else
+    (void)task;
+    (void)slot;
+#endif
 }
 
 bool Watchdog::updateFeedTime(TaskHandle_t handle) {
-    TaskInfo* info = findTaskByHandle(handle);
-    if (info) {
-        info->lastFeedTime = xTaskGetTickCount();
-        info->missedFeeds = 0;
+    size_t slot = findTaskByHandle(handle);
+    if (slot != NO_SLOT) {
+        updateFeedTime(slot, xTaskGetTickCount());
         return true;
     }
     return false;
 }
 
+void Watchdog::FeedHandle::reset() noexcept {
+    if (isValid()) {
+        watchdog_->removeTask(task_, slot_, nullptr);
+    }
+    watchdog_ = nullptr;
+}
+
 esp_err_t Watchdog::initWatchdogESPIDF() {
     esp_err_t err;
     
     #if ESP_IDF_VERSION_MAJOR >= 5
     // New API for ESP-IDF v5.x
     esp_task_wdt_config_t wdtConfig = {
-        .timeout_ms = timeoutMs_,
+        .timeout_ms = getTimeoutMs(),
         .idle_core_mask = 0,  // Don't watch idle tasks
         .trigger_panic = panicOnTimeout_
     };
     err = esp_task_wdt_init(&wdtConfig);
     #else
     // Legacy API for ESP-IDF v4.x and earlier
-    err = esp_task_wdt_init(timeoutMs_ / 1000, panicOnTimeout_);
+    err = esp_task_wdt_init(getTimeoutMs() / 1000, panicOnTimeout_);
     #endif
     
     return err;
@@ -19,13 +19,24 @@
 #include <esp_task_wdt.h>
 #include <esp_err.h>
 #include <atomic>
-#include <vector>
 #include <cstring>
 
 // Include logging configuration (C++11 compatible)
+#include "WatchdogConfig.h"
 #include "WatchdogLog.h"
+#include "WatchdogScan.h"
+#include "WatchdogIndex.h"
+#include "WatchdogSnapshot.h"
 #include "IWatchdog.h"
 
+#ifdef WATCHDOG_FEED_IN_IRAM
+    #if ESP_IDF_VERSION_MAJOR >= 5
+        #include <esp_private/cache_utils.h>
+    #else
+        #include <esp_spi_flash.h>
+    #endif
+#endif
+
 /**
  * @class Watchdog
  * @brief Singleton manager for ESP32 task watchdog timer with thread safety
@@ -37,7 +48,7 @@
  * Features:
  * - Singleton pattern ensures only one instance manages ESP-IDF TWDT
  * - Automatic ESP-IDF version detection and API adaptation
- * - Thread-safe task registration and feeding
+ * - Thread-safe task registration and lock-free feeding
  * - Per-task timeout tracking
  * - Graceful error handling
  * - Support for both critical and non-critical tasks
@@ -71,29 +82,40 @@
  *     }
  * }
  * @endcode
+ *
+ * The class is final, so calls through a Watchdog reference (including the
+ * static convenience methods) are statically dispatched. See
+ * WatchdogStatic.h for a front-end that selects the implementation at
+ * compile time.
  */
-class Watchdog : public IWatchdog {
+class Watchdog final : public IWatchdog {
 private:
     /**
      * @brief Private constructor for singleton pattern
+     *
+     * constexpr, so the singleton is constant-initialized: it exists
+     * before any global constructor runs and getInstance() has no guard.
+     * Every array starts zeroed; the registry mutex and the free list are
+     * set up by init().
      */
-    Watchdog() : initialized_(false), timeoutMs_(DEFAULT_TIMEOUT_MS), 
-                 panicOnTimeout_(true), taskListMutex_(nullptr) {
-        taskListMutex_ = xSemaphoreCreateMutex();
-        configASSERT(taskListMutex_ != nullptr);
-    }
+    constexpr Watchdog() : initialized_(false), timeoutMs_(DEFAULT_TIMEOUT_MS),
+                 panicOnTimeout_(true), coalesceWindowTicks_(0), taskListMutex_(nullptr),
+                 taskListMutexBuffer_(), slotHandles_(), deadlines_(), graceTicks_(),
+                 slotFlags_(), slotGenerations_(), slotSequences_(), registeredCount_(0), unhealthyMask_(),
+                 nextFree_(), shards_(), staticTaskCount_(0), handleIndex_(), nameIndex_()
+#if WATCHDOG_PENDING_REGISTRATIONS > 0
+                 , pending_(), pendingState_(0)
+#endif
+                 {}
     
     /**
      * @brief Private destructor - watchdog singleton should never be destroyed
+     *
+     * Trivial, so no exit-time destructor is registered for the singleton
+     * and it is dropped from the link like any unreferenced constant data.
+     * The mutexes are statically allocated and need no teardown.
      */
-    ~Watchdog() {
-        if (initialized_) {
-            deinit();
-        }
-        if (taskListMutex_) {
-            vSemaphoreDelete(taskListMutex_);
-        }
-    }
+    ~Watchdog() = default;
     
     // Delete copy and move constructors/operators
     Watchdog(const Watchdog&) = delete;
@@ -106,54 +128,440 @@ public:
     static constexpr size_t MAX_TASK_NAME_LEN = configMAX_TASK_NAME_LEN;
     static constexpr uint32_t DEFAULT_TIMEOUT_MS = 30000;  // 30 seconds
     static constexpr uint32_t MIN_TIMEOUT_MS = 1000;       // 1 second
+    static constexpr size_t MAX_TASKS = WATCHDOG_MAX_TASKS;
+    static_assert(MAX_TASKS > 0 && MAX_TASKS < 0xFFFF,
+                  "WATCHDOG_MAX_TASKS must be between 1 and 65534");
+    static constexpr size_t SHARDS = WATCHDOG_CORE_SHARDS;  // Registry shards, one per core
+    static_assert(SHARDS >= 1 && SHARDS <= MAX_TASKS,
+                  "WATCHDOG_CORE_SHARDS must be between 1 and WATCHDOG_MAX_TASKS");
+    static constexpr size_t PENDING_REGISTRATIONS = WATCHDOG_PENDING_REGISTRATIONS;  // Queued before init()
+    static_assert(PENDING_REGISTRATIONS <= MAX_TASKS,
+                  "WATCHDOG_PENDING_REGISTRATIONS must not exceed WATCHDOG_MAX_TASKS");
+#ifdef WATCHDOG_COMPACT_TASKINFO
+    static_assert(WATCHDOG_INTERVAL_UNIT_MS >= 1 && WATCHDOG_INTERVAL_UNIT_MS <= 65537,
+                  "WATCHDOG_INTERVAL_UNIT_MS must be between 1 and 65537");
+    // Longest feed interval a slot can store: 65535 units
+    static constexpr uint32_t MAX_FEED_INTERVAL_MS = 0xFFFFUL * WATCHDOG_INTERVAL_UNIT_MS;
+#else
+    static constexpr uint32_t MAX_FEED_INTERVAL_MS = 0xFFFFFFFF;  // Longest feed interval
+#endif
     
     /**
-     * @brief Task registration info for internal tracking
+     * @brief Identifies a heartbeat returned by registerHeartbeat()
+     *
+     * Encodes the registry slot and the slot's generation, so the id of an
+     * unregistered heartbeat is rejected even after its slot is reused.
+     */
+    typedef uint32_t HeartbeatId;
+    static constexpr HeartbeatId INVALID_HEARTBEAT = 0xFFFFFFFF;
+    
+    /**
+     * @brief Snapshot of one registry entry, as returned by getTaskInfo()
+     *
+     * The registry itself is stored as separate hot and cold arrays; this
+     * record gathers one entry's fields for callers.
      */
     struct TaskInfo {
-        TaskHandle_t handle;
+        std::atomic<TaskHandle_t> handle;
         char name[MAX_TASK_NAME_LEN];
-        TickType_t lastFeedTime;
+        std::atomic<TickType_t> lastFeedTime;
         uint32_t feedIntervalMs;
         std::atomic<uint32_t> missedFeeds{0};
+        std::atomic<uint32_t> coalescedFeeds{0};  // Feeds skipped by coalescing
         bool isCritical;
+        bool twdtSubscribed;  // Task is subscribed to the ESP-IDF TWDT
+        bool isHeartbeat;     // Entry is a heartbeat rather than a task
         
-        TaskInfo() : handle(nullptr), lastFeedTime(0), feedIntervalMs(0), isCritical(false) {
+        TaskInfo() : handle(nullptr), lastFeedTime(0), feedIntervalMs(0), isCritical(false),
+                     twdtSubscribed(false), isHeartbeat(false) {
             memset(name, 0, MAX_TASK_NAME_LEN);
         }
         
         // Copy constructor
         TaskInfo(const TaskInfo& other) 
-            : handle(other.handle), 
-              lastFeedTime(other.lastFeedTime),
+            : handle(other.handle.load()), 
+              lastFeedTime(other.lastFeedTime.load()),
               feedIntervalMs(other.feedIntervalMs),
               missedFeeds(other.missedFeeds.load()),
-              isCritical(other.isCritical) {
+              coalescedFeeds(other.coalescedFeeds.load()),
+              isCritical(other.isCritical),
+              twdtSubscribed(other.twdtSubscribed),
+              isHeartbeat(other.isHeartbeat) {
             memcpy(name, other.name, MAX_TASK_NAME_LEN);
         }
         
         // Copy assignment
         TaskInfo& operator=(const TaskInfo& other) {
             if (this != &other) {
-                handle = other.handle;
+                handle = other.handle.load();
                 memcpy(name, other.name, MAX_TASK_NAME_LEN);
-                lastFeedTime = other.lastFeedTime;
+                lastFeedTime = other.lastFeedTime.load();
                 feedIntervalMs = other.feedIntervalMs;
                 missedFeeds = other.missedFeeds.load();
+                coalescedFeeds = other.coalescedFeeds.load();
                 isCritical = other.isCritical;
+                twdtSubscribed = other.twdtSubscribed;
+                isHeartbeat = other.isHeartbeat;
             }
             return *this;
         }
     };
     
+    /**
+     * @brief A task known at build time
+     *
+     * Pass an array of specs to init(); the task at index i is given slot
+     * i and binds to it with bindStaticTask(i). Check the table at compile
+     * time with validStaticTasks():
+     *
+     * @code
+     * static constexpr Watchdog::StaticTaskSpec TASKS[] = {
+     *     {"Sensor", 1000, true},
+     *     {"Network", 5000, false},
+     * };
+     * static_assert(Watchdog::validStaticTasks(TASKS, 30), "Bad watchdog task table");
+     * static constexpr size_t SENSOR_TASK = Watchdog::staticTaskIndex(TASKS, "Sensor");
+     * @endcode
+     */
+    struct StaticTaskSpec {
+        const char* name;
+        uint32_t feedIntervalMs;  // 0 = auto-calculate
+        bool isCritical;
+    };
+    
+    /**
+     * @brief One task of a registerTasks() batch
+     */
+    struct TaskRegistration {
+        TaskHandle_t handle;
+        const char* name;         // nullptr = the task's FreeRTOS name
+        uint32_t feedIntervalMs;  // 0 = auto-calculate
+        bool isCritical;
+    };
+    
+    /**
+     * @brief Check a static task table at compile time
+     * @param tasks Task table
+     * @param timeoutSeconds Timeout that will be passed to init()
+     * @return true if the table fits the registry, every name is non-empty
+     *         and unique, and every task is due (twice its feed interval)
+     *         before the TWDT timeout, with an interval of at most
+     *         MAX_FEED_INTERVAL_MS
+     */
+    template <size_t N>
+    static constexpr bool validStaticTasks(const StaticTaskSpec (&tasks)[N],
+                                           uint32_t timeoutSeconds) {
+        return N <= MAX_TASKS && staticIntervalsFit(tasks, timeoutSeconds * 1000ULL, 0) &&
+               staticNamesUnique(tasks, 0);
+    }
+    
+    /**
+     * @brief Index of a named task in a static task table, at compile time
+     * @return Index, or N if @p name is not in the table
+     */
+    template <size_t N>
+    static constexpr size_t staticTaskIndex(const StaticTaskSpec (&tasks)[N], const char* name,
+                                            size_t i = 0) {
+        return (i == N || namesEqual(tasks[i].name, name, 0)) ? i :
+               staticTaskIndex(tasks, name, i + 1);
+    }
+    
+private:
+    /**
+     * @brief std::atomic whose default constructor is constexpr and zeroes it
+     *
+     * Before C++20, value-initializing an array of std::atomic is not a
+     * constant expression, which would make the singleton's construction
+     * dynamic.
+     */
+    template <typename T>
+    struct ZeroedAtomic : std::atomic<T> {
+        constexpr ZeroedAtomic() : std::atomic<T>(T()) {}
+        using std::atomic<T>::operator=;
+    };
+    
+    template <size_t N>
+    static constexpr bool staticIntervalsFit(const StaticTaskSpec (&tasks)[N],
+                                             unsigned long long timeoutMs, size_t i) {
+        return i == N || (2ULL * tasks[i].feedIntervalMs < timeoutMs &&
+                          tasks[i].feedIntervalMs <= MAX_FEED_INTERVAL_MS &&
+                          staticIntervalsFit(tasks, timeoutMs, i + 1));
+    }
+    
+    template <size_t N>
+    static constexpr bool staticNameUniqueFrom(const StaticTaskSpec (&tasks)[N], size_t i,
+                                               size_t j) {
+        return j == N || (!namesEqual(tasks[i].name, tasks[j].name, 0) &&
+                          staticNameUniqueFrom(tasks, i, j + 1));
+    }
+    
+    template <size_t N>
+    static constexpr bool staticNamesUnique(const StaticTaskSpec (&tasks)[N], size_t i) {
+        return i == N || (tasks[i].name != nullptr && tasks[i].name[0] != '\0' &&
+                          staticNameUniqueFrom(tasks, i, i + 1) && staticNamesUnique(tasks, i + 1));
+    }
+    
+    // Names are compared as stored: truncated to MAX_TASK_NAME_LEN - 1 characters
+    static constexpr bool namesEqual(const char* a, const char* b, size_t i) {
+        return i == MAX_TASK_NAME_LEN - 1 ||
+               (a[i] == b[i] && (a[i] == '\0' || namesEqual(a, b, i + 1)));
+    }
+    
+#ifdef WATCHDOG_COMPACT_TASKINFO
+    static constexpr size_t NAME_TABLE_SIZE = WATCHDOG_NAME_TABLE_SIZE;
+    static_assert(NAME_TABLE_SIZE >= 1 && NAME_TABLE_SIZE <= 0x7FFF,
+                  "WATCHDOG_NAME_TABLE_SIZE must be between 1 and 32767");
+    
+    /**
+     * @brief Interned name, shared by every slot registered under it
+     */
+    struct NameEntry {
+        char name[MAX_TASK_NAME_LEN];
+        uint16_t refs;  // Slots using the entry; 0 = free
+        
+    };
+    
+    typedef uint16_t MissedCount;
+    
+    /**
+     * @brief Per-slot fields that feed() and checkHealth() never touch
+     */
+    struct SlotDetails {
+        uint16_t nameRef : 15;  // Entry in names_
+        uint16_t isCritical : 1;
+        uint16_t feedInterval;  // In WATCHDOG_INTERVAL_UNIT_MS units
+        std::atomic<MissedCount> missedFeeds;
+#ifndef WATCHDOG_HOT_FEED_COUNTERS
+        std::atomic<uint32_t> coalescedFeeds;  // Feeds skipped by coalescing
+#endif
+    };
+#else
+    typedef uint32_t MissedCount;
+    
+    /**
+     * @brief Per-slot fields that feed() and checkHealth() never touch
+     */
+    struct SlotDetails {
+        char name[MAX_TASK_NAME_LEN];
+        uint32_t nameHash;  // Key in nameIndex_
+        uint32_t feedIntervalMs;
+        std::atomic<MissedCount> missedFeeds;
+#ifndef WATCHDOG_HOT_FEED_COUNTERS
+        std::atomic<uint32_t> coalescedFeeds;  // Feeds skipped by coalescing
+#endif
+        bool isCritical;
+    };
+#endif
+    
+    /**
+     * @brief Per-slot state written by the feeding task
+     *
+     * Normally just the deadline, packed into a dense array for the health
+     * scan. With WATCHDOG_CACHE_ALIGNED_SLOTS or WATCHDOG_COLD_IN_PSRAM each
+     * cell also carries the coalesced feed counter, and with the former it
+     * fills a cache line of its own.
+     */
+    struct WATCHDOG_SLOT_ALIGN FeedCell {
+        std::atomic<TickType_t> deadline;
+#ifdef WATCHDOG_HOT_FEED_COUNTERS
+        std::atomic<uint32_t> coalescedFeeds;
+        
+        constexpr FeedCell() : deadline(0), coalescedFeeds(0) {}
+#else
+        constexpr FeedCell() : deadline(0) {}
+#endif
+        
+        WATCHDOG_FEED_INLINE TickType_t load(std::memory_order order) const {
+            return deadline.load(order);
+        }
+        WATCHDOG_FEED_INLINE void store(TickType_t value, std::memory_order order) {
+            deadline.store(value, order);
+        }
+        WATCHDOG_FEED_INLINE TickType_t exchange(TickType_t value, std::memory_order order) {
+            return deadline.exchange(value, order);
+        }
+        WATCHDOG_FEED_INLINE bool compareExchange(TickType_t& expected, TickType_t value,
+                                                  std::memory_order order) {
+            return deadline.compare_exchange_strong(expected, value, order,
+                                                    std::memory_order_relaxed);
+        }
+    };
+    
+#ifdef WATCHDOG_REGISTRY_SNAPSHOTS
+    /**
+     * @brief A slot's registration as of one registry snapshot
+     */
+    struct SnapshotEntry {
+        TaskHandle_t handle;  // nullptr: slot not registered
+        char name[MAX_TASK_NAME_LEN];
+        uint16_t generation;  // Slot generation of this registration
+    };
+    
+    /**
+     * @brief Immutable copy of the registry membership, with its own name index
+     */
+    struct RegistrySnapshot {
+        uint32_t version;
+        uint16_t byName[WatchdogIndex::bucketsFor(MAX_TASKS)];  // Slot + 1 by name hash; 0 = vacant
+        SnapshotEntry entries[MAX_TASKS];                       // By slot
+    };
+    
+    typedef WatchdogSnapshot::DoubleBuffer<RegistrySnapshot> SnapshotBuffer;
+#endif
+    
+#if WATCHDOG_PENDING_REGISTRATIONS > 0
+    // PendingRegistration::state values
+    static constexpr uint8_t PENDING_EMPTY = 0;      // Free, or reserved and being filled
+    static constexpr uint8_t PENDING_READY = 1;      // Filled; applied by init()
+    static constexpr uint8_t PENDING_CANCELLED = 2;  // Unregistered before init()
+    
+    /**
+     * @brief A registerCurrentTask() call made before init()
+     */
+    struct PendingRegistration {
+        TaskHandle_t handle;
+        uint32_t feedIntervalMs;
+        char name[MAX_TASK_NAME_LEN];  // Empty: use the FreeRTOS task name
+        std::atomic<uint8_t> state;    // PENDING_*
+        bool isCritical;
+        
+        constexpr PendingRegistration()
+            : handle(nullptr), feedIntervalMs(0), name(), state(PENDING_EMPTY), isCritical(false) {}
+    };
+#endif
+    
+public:
+    /**
+     * @brief Bytes of static RAM used by each registry slot
+     *
+     * Excludes the lookup indexes and, with WATCHDOG_COMPACT_TASKINFO, the
+     * shared name table, both of which REGISTRY_BYTES includes.
+     */
+    static constexpr size_t SLOT_BYTES =
+        sizeof(std::atomic<TaskHandle_t>) + sizeof(FeedCell) + sizeof(TickType_t) +
+        sizeof(std::atomic<uint8_t>) + 3 * sizeof(std::atomic<uint16_t>) + sizeof(SlotDetails);
+    
+    /**
+     * @brief Bytes of static RAM used by the task registry
+     */
+    static constexpr size_t REGISTRY_BYTES =
+        SLOT_BYTES * MAX_TASKS +
+#ifdef WATCHDOG_COMPACT_TASKINFO
+        sizeof(NameEntry) * NAME_TABLE_SIZE +
+#endif
+        sizeof(uint32_t) * ((MAX_TASKS + 31) / 32) +  // Unhealthy bitmap
+#ifdef WATCHDOG_REGISTRY_SNAPSHOTS
+        sizeof(SnapshotBuffer) +
+#endif
+#if WATCHDOG_PENDING_REGISTRATIONS > 0
+        sizeof(PendingRegistration) * PENDING_REGISTRATIONS +
+#endif
+        2 * sizeof(WatchdogIndex::SlotIndex<WatchdogIndex::bucketsFor(MAX_TASKS)>);
+    
+    /**
+     * @brief Part of REGISTRY_BYTES held in the cold arrays
+     *
+     * This is what WATCHDOG_COLD_IN_PSRAM moves to external RAM.
+     */
+    static constexpr size_t COLD_BYTES =
+#ifdef WATCHDOG_COMPACT_TASKINFO
+        sizeof(NameEntry) * NAME_TABLE_SIZE +
+#endif
+        sizeof(SlotDetails) * MAX_TASKS;
+    
+    /**
+     * @class FeedHandle
+     * @brief Move-only token bound to a registered task's slot
+     *
+     * Returned by registerCurrentTaskWithHandle(). feed() is inline and
+     * writes straight to the bound slot: no xTaskGetCurrentTaskHandle(),
+     * no registry lookup and no IWatchdog virtual dispatch. Destroying the
+     * handle unregisters the task. The handle remembers the slot's
+     * generation, so once the registration ends it stops working, even if
+     * the slot is reused by a task with the same TaskHandle_t.
+     *
+     * @code
+     * void myTask(void* params) {
+     *     Watchdog::FeedHandle wdt =
+     *         Watchdog::getInstance().registerCurrentTaskWithHandle("MyTask");
+     *     while (true) {
+     *         // Do work...
+     *         wdt.feed();
+     *         vTaskDelay(pdMS_TO_TICKS(1000));
+     *     }
+     * }
+     * @endcode
+     *
+     * @note Like Watchdog::feed(), feed() MUST be called from the owning task
+     */
+    class FeedHandle {
+    public:
+        FeedHandle() noexcept : watchdog_(nullptr), slot_(0), generation_(0), task_(nullptr) {}
+        
+        FeedHandle(FeedHandle&& other) noexcept
+            : watchdog_(other.watchdog_), slot_(other.slot_), generation_(other.generation_),
+              task_(other.task_) {
+            other.watchdog_ = nullptr;
+        }
+        
+        FeedHandle& operator=(FeedHandle&& other) noexcept {
+            if (this != &other) {
+                reset();
+                watchdog_ = other.watchdog_;
+                slot_ = other.slot_;
+                generation_ = other.generation_;
+                task_ = other.task_;
+                other.watchdog_ = nullptr;
+            }
+            return *this;
+        }
+        
+        FeedHandle(const FeedHandle&) = delete;
+        FeedHandle& operator=(const FeedHandle&) = delete;
+        
+        /**
+         * @brief Unregisters the task if the handle is still bound
+         */
+        ~FeedHandle() { reset(); }
+        
+        /**
+         * @brief Feed the watchdog for the bound task
+         * @return true if fed, false if the handle is empty or the task was
+         *         unregistered by other means (e.g. deinit())
+         */
+        inline bool feed() noexcept;
+        
+        /**
+         * @brief Unregister the bound task and empty the handle
+         */
+        void reset() noexcept;
+        
+        /**
+         * @brief Check if the handle is bound to a registered task
+         */
+        inline bool isValid() const noexcept;
+        
+        explicit operator bool() const noexcept { return isValid(); }
+        
+    private:
+        friend class Watchdog;
+        
+        FeedHandle(Watchdog* watchdog, size_t slot, uint16_t generation, TaskHandle_t task) noexcept
+            : watchdog_(watchdog), slot_(slot), generation_(generation), task_(task) {}
+        
+        Watchdog* watchdog_;  // nullptr = empty handle
+        size_t slot_;
+        uint16_t generation_;
+        TaskHandle_t task_;
+    };
+    
     /**
      * @brief Get the singleton instance of Watchdog
      * @return Reference to the singleton Watchdog instance
      * @note Thread-safe initialization guaranteed by C++11
      */
     static Watchdog& getInstance() {
-        static Watchdog instance;
-        return instance;
+        return instance_;
     }
     
     // ============== IWatchdog Interface Implementation ==============
@@ -165,10 +573,29 @@ public:
      * @return true if initialization successful
      */
     bool init(uint32_t timeoutSeconds = 30, bool panicOnTimeout = true) noexcept override;
+    
+    /**
+     * @brief Initialize the watchdog timer and reserve slots for static tasks
+     * @param timeoutSeconds Timeout in seconds before watchdog triggers
+     * @param panicOnTimeout If true, system will panic/reset on timeout
+     * @param tasks Tasks known at build time; task i gets slot i
+     * @return true if initialization successful, false also if the watchdog
+     *         was already initialized or a task's interval does not fit the timeout
+     * @note Names and intervals are stored here, once; each task then calls
+     *       bindStaticTask() with its index
+     */
+    template <size_t N>
+    bool init(uint32_t timeoutSeconds, bool panicOnTimeout,
+              const StaticTaskSpec (&tasks)[N]) noexcept {
+        static_assert(N <= MAX_TASKS, "More static tasks than WATCHDOG_MAX_TASKS");
+        return initWithStaticTasks(timeoutSeconds, panicOnTimeout, tasks, N);
+    }
 
     /**
      * @brief Deinitialize the watchdog timer
      * @return true if deinitialization successful
+     * @note Unregisters every task in one pass: the slot table and lookup
+     *       indexes are cleared wholesale rather than slot by slot
      */
     bool deinit() noexcept override;
 
@@ -178,10 +605,47 @@ public:
      * @param isCritical If true, timeout will trigger panic
      * @param feedIntervalMs Expected feed interval (0 = auto-calculate)
      * @return true if registration successful
+     * @note Before init(), the registration is queued (up to
+     *       WATCHDOG_PENDING_REGISTRATIONS calls) and init() applies the
+     *       queue in one batch; until then feed() has no effect.
+     *       unregisterCurrentTask() withdraws the entry for reuse. A queued
+     *       task MUST unregister before it is deleted: init() registers the
+     *       queued handles as they are, with no way to tell a deleted task.
      */
     bool registerCurrentTask(const char* taskName, bool isCritical = true,
                            uint32_t feedIntervalMs = 0) noexcept override;
 
+    /**
+     * @brief Register current task and return a handle for feeding it
+     * @param taskName Name for identification
+     * @param isCritical If true, timeout will trigger panic
+     * @param feedIntervalMs Expected feed interval (0 = auto-calculate)
+     * @return Bound FeedHandle, or an empty one if registration failed
+     * @note MUST be called from task context; the task is unregistered
+     *       when the returned handle is destroyed
+     */
+    FeedHandle registerCurrentTaskWithHandle(const char* taskName, bool isCritical = true,
+                                             uint32_t feedIntervalMs = 0) noexcept;
+
+    /**
+     * @brief Bind the current task to its reserved slot
+     * @param index Index of the task in the table passed to init()
+     * @return true if bound
+     * @note MUST be called from task context. No name lookup, name copy or
+     *       allocation: the slot was filled by init(). Fails if another
+     *       task holds the slot or the calling task is already registered
+     *       under another slot. Unregistering keeps the slot reserved, so
+     *       the task can bind again later.
+     */
+    bool bindStaticTask(size_t index) noexcept;
+    
+    /**
+     * @brief Bind the current task to its reserved slot and return a handle for feeding it
+     * @param index Index of the task in the table passed to init()
+     * @return Bound FeedHandle, or an empty one if binding failed
+     */
+    FeedHandle bindStaticTaskWithHandle(size_t index) noexcept;
+
     /**
      * @brief Unregister current task from watchdog
      * @return true if unregistration successful
@@ -196,48 +660,261 @@ public:
      * @note Can be called from any task context
      */
     bool unregisterTaskByHandle(TaskHandle_t taskHandle, const char* taskName = nullptr) noexcept override;
+    
+    /**
+     * @brief Register several tasks by handle in one registry transaction
+     * @param tasks Tasks to register
+     * @param count Number of entries in @p tasks
+     * @return Number of tasks registered, including ones that already were
+     * @note Can be called from any task context, e.g. by the task that
+     *       creates the others at boot. Each task is subscribed to the
+     *       ESP-IDF TWDT; the lookup indexes and the registry snapshot are
+     *       updated once per REGISTER_BATCH (16) new tasks, and one summary
+     *       is logged.
+     *       A task must not register itself while it is in a batch.
+     * @note The TWDT has one timer shared by all subscribers, restarted only
+     *       once each of them has reset it, and a new subscriber has not.
+     *       Every task in the batch other than the caller must therefore
+     *       feed() before the current TWDT period ends: within one timeout
+     *       of registration at most, possibly less.
+     */
+    size_t registerTasks(const TaskRegistration* tasks, size_t count) noexcept;
+    
+    /**
+     * @brief Unregister several tasks by handle in one registry transaction
+     * @param handles Tasks to unregister
+     * @param count Number of entries in @p handles
+     * @return Number of tasks that were registered and are now removed
+     * @note Can be called from any task context; logs one summary
+     */
+    size_t unregisterTasks(const TaskHandle_t* handles, size_t count) noexcept;
 
     /**
      * @brief Feed the watchdog for current task
      * @return true if feed successful
      * @note MUST be called from registered task context
+     * @note Tasks not registered through registerCurrentTask() are accepted
+     *       silently; if they are subscribed to the TWDT directly (loopTask,
+     *       esp_task_wdt_add()) it is reset after an esp_task_wdt_status() check
+     *
+     * Cost by path. feed() never blocks in any of them; the only shared
+     * lock it can meet is the short TWDT spinlock inside ESP-IDF.
+     * - Cached slot (WATCHDOG_TLS_INDEX >= 0, task registered through this
+     *   library): one TLS pointer read, xTaskGetTickCount(), six atomic
+     *   loads (seven with coalescing), one atomic exchange and one
+     *   esp_task_wdt_reset(). A feed racing the slot's release adds one
+     *   compare-exchange and skips the reset. Independent of registry size.
+     * - No cache (WATCHDOG_TLS_INDEX < 0, which is the stock sdkconfig) or
+     *   a cache miss: feedSlow() first probes the handle index, constant
+     *   expected time but every bucket at worst, and if a concurrent
+     *   registration changes the index mid-probe it scans all
+     *   WATCHDOG_MAX_TASKS slots. The cached-path work follows.
+     * - Task not registered with the library: the same lookup, then
+     *   esp_task_wdt_status() and esp_task_wdt_reset(), each of which walks
+     *   the TWDT subscriber list.
+     *
+     * Activity on the other core costs a feed at most the scan fallback,
+     * a wait for the TWDT spinlock and cache line transfers. With
+     * interrupts masked, test/test_feed_latency.cpp measures the worst
+     * case on the board under test with the other core idle, then requires
+     * the worst case during checkHealth(), logging and registration churn
+     * there to stay within 4x of it; it prints both in cycles and us.
+     *
+     * The cached-slot fast path is inline; everything else is in feedSlow().
+     * With WATCHDOG_FEED_IN_IRAM, feed() is instead an out-of-line IRAM
+     * function so its placement does not depend on the caller's.
      */
+#ifdef WATCHDOG_FEED_IN_IRAM
     bool feed() noexcept override;
+#else
+    bool feed() noexcept override { return feedFast(); }
+#endif
 
     /**
      * @brief Check if watchdog is initialized
      * @return true if initialized
      */
-    bool isInitialized() const noexcept override { return initialized_; }
+    bool isInitialized() const noexcept override {
+        return initialized_.load(std::memory_order_acquire);
+    }
 
     /**
      * @brief Get current timeout in milliseconds
      * @return Timeout in milliseconds
      */
-    uint32_t getTimeoutMs() const noexcept override { return timeoutMs_; }
+    uint32_t getTimeoutMs() const noexcept override {
+        return timeoutMs_.load(std::memory_order_relaxed);
+    }
 
     /**
      * @brief Get number of registered tasks
-     * @return Number of tasks registered with watchdog
+     * @return Number of tasks (and heartbeats) registered with watchdog
+     * @note Wait-free; safe from ISRs and while the registry mutex is held
      */
-    size_t getRegisteredTaskCount() const noexcept override;
+    size_t getRegisteredTaskCount() const noexcept override {
+        return registeredCount_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get number of tasks found late by the last health check
+     * @return Number of tasks (and heartbeats) that missed their feed at
+     *         the last checkHealth() and have not been seen fed since
+     * @note Wait-free; safe from ISRs. Reads the bitmap that checkHealth()
+     *       maintains rather than scanning deadlines, so it is only as
+     *       fresh as the last scan.
+     */
+    size_t getUnhealthyTaskCount() const noexcept {
+        size_t count = 0;
+        for (size_t i = 0; i < HEALTH_WORDS; i++) {
+            count += __builtin_popcount(unhealthyMask_[i].load(std::memory_order_relaxed));
+        }
+        return count;
+    }
 
     /**
      * @brief Check health of all registered tasks
      * @return Number of tasks that haven't fed watchdog recently
+     * @note Runs the health pass of every shard in turn (see
+     *       checkCoreHealth()).
      */
     size_t checkHealth() noexcept override;
+    
+    /**
+     * @brief Check health of the tasks in one core's registry shard
+     * @param core Core whose shard to scan, e.g. xPortGetCoreID() from a
+     *        monitor task pinned to that core
+     * @return Number of tasks in the shard that haven't fed watchdog recently
+     * @note The shard is scanned in batches of 16 slots. Each batch is
+     *       judged against one tick sample taken under the shard's own
+     *       lock, in a single pass over its deadline and flag arrays, and
+     *       its warnings are logged after the lock is released. Passes on
+     *       different shards never wait for each other. Stack use is fixed
+     *       (about 400 bytes) whatever the shard size.
+     */
+    size_t checkCoreHealth(BaseType_t core) noexcept;
 
     // ============== Non-Interface Methods ==============
 
+    /**
+     * @brief Register a heartbeat for work that makes progress outside a task
+     * @param name Name for identification
+     * @param feedIntervalMs Expected feed interval (0 = auto-calculate)
+     * @return Heartbeat id, or INVALID_HEARTBEAT on failure
+     *
+     * Heartbeats let ISRs and deferred-interrupt callbacks (esp_timer,
+     * timer service, xTimerPendFunctionCallFromISR) report progress. They
+     * occupy a registry slot and take part in checkHealth() exactly like
+     * tasks, but are not subscribed to the ESP-IDF TWDT.
+     *
+     * @note Call from task context; feed from anywhere
+     */
+    HeartbeatId registerHeartbeat(const char* name, uint32_t feedIntervalMs = 0) noexcept;
+    
+    /**
+     * @brief Unregister a heartbeat
+     * @param id Id returned by registerHeartbeat()
+     * @return true if the heartbeat was registered
+     * @note Constant time
+     */
+    bool unregisterHeartbeat(HeartbeatId id) noexcept;
+    
+    /**
+     * @brief Record progress for a heartbeat from task context
+     * @param id Id returned by registerHeartbeat()
+     * @return true if the heartbeat is registered and stayed so for the feed
+     */
+    bool feedHeartbeat(HeartbeatId id) noexcept;
+    
+    /**
+     * @brief Record progress for a heartbeat from interrupt context
+     * @param id Id returned by registerHeartbeat()
+     * @return true if the heartbeat is registered and stayed so for the feed
+     * @note ISR-safe: lock-free, uses xTaskGetTickCountFromISR() and never logs
+     */
+    bool feedFromISR(HeartbeatId id) noexcept;
+    
     /**
      * @brief Get task info by name
      * @param taskName Name of task to find
      * @param info Output parameter for task info
      * @return true if task found
+     * @note The fields are copied under the slot's sequence lock, so they
+     *       always describe one consistent state of the entry (a missed-feed
+     *       count never pairs with a feed time from after it was reset).
+     *       Feeders never wait for readers. With WATCHDOG_REGISTRY_SNAPSHOTS
+     *       the name is looked up in the current registry snapshot and the
+     *       registry mutex is never taken.
      */
     bool getTaskInfo(const char* taskName, TaskInfo& info) const;
     
+#ifdef WATCHDOG_REGISTRY_SNAPSHOTS
+    /**
+     * @brief Visit every registered task and heartbeat
+     * @param visit Called as visit(const TaskInfo&) once per entry
+     * @return Number of entries visited
+     * @note Lock-free: walks the current registry snapshot, so it never
+     *       waits for registration, health checks or other readers and
+     *       never touches the feed path. Entries registered after the
+     *       snapshot was published are not visited; entries unregistered
+     *       since are skipped. The visitor must not register or unregister
+     *       anything, since publishing can wait for readers to leave.
+     */
+    template <typename Visitor>
+    size_t forEachTask(Visitor visit) const {
+        uint8_t token = snapshots_.enter();
+        const RegistrySnapshot& snapshot = snapshots_.get(token);
+        TaskInfo info;
+        size_t visited = 0;
+        for (size_t i = 0; i < MAX_TASKS; i++) {
+            if (readSnapshotEntry(snapshot, i, info)) {
+                visit(static_cast<const TaskInfo&>(info));
+                visited++;
+            }
+        }
+        snapshots_.leave(token);
+        return visited;
+    }
+    
+    /**
+     * @brief Version of the current registry snapshot
+     * @return Number of snapshots published; changes whenever an entry is
+     *         registered or unregistered
+     */
+    uint32_t getSnapshotVersion() const {
+        uint8_t token = snapshots_.enter();
+        uint32_t version = snapshots_.get(token).version;
+        snapshots_.leave(token);
+        return version;
+    }
+#endif
+    
+    /**
+     * @brief Enable or disable feed coalescing
+     * @param windowMs Feeds arriving within this many milliseconds of the
+     *        task's last recorded feed return immediately, without touching
+     *        the slot or calling esp_task_wdt_reset() (0 = disabled)
+     * @return true if accepted, false if the window is not shorter than
+     *         the default feed interval (timeout / 5)
+     * @note Opt-in. Intended for tight loops that feed far more often than
+     *       needed, e.g. a window of getTimeoutMs() / 100. Tasks whose feed
+     *       interval is not longer than the window are never coalesced.
+     */
+    bool setFeedCoalescing(uint32_t windowMs) noexcept;
+    
+    /**
+     * @brief Get the feed coalescing window
+     * @return Window in milliseconds (0 = disabled)
+     */
+    uint32_t getFeedCoalescing() const noexcept {
+        return coalesceWindowTicks_.load(std::memory_order_relaxed) * portTICK_PERIOD_MS;
+    }
+    
+    /**
+     * @brief Get number of feeds skipped by coalescing
+     * @return Sum of the coalesced feed counts of all registered tasks
+     */
+    uint32_t getCoalescedFeedCount() const noexcept;
+    
     // ============== Static Convenience Methods ==============
     
     /**
@@ -255,7 +932,7 @@ public:
      * @return true if feed successful
      */
     static bool quickFeed() {
-        return getInstance().feed();
+        return instance_.feed();
     }
     
     /**
@@ -295,18 +972,368 @@ public:
     }
 
 private:
+    static Watchdog instance_;  // Constant-initialized, see the constructor
+    
+    static constexpr size_t NO_SLOT = MAX_TASKS;  // Returned by lookups that find nothing
+    static constexpr uint16_t FREE_END = 0xFFFF;  // Terminates the free list
+    static constexpr size_t HEALTH_WORDS = (MAX_TASKS + 31) / 32;
+    static constexpr size_t INDEX_BUCKETS = WatchdogIndex::bucketsFor(MAX_TASKS);
+    typedef WatchdogIndex::SlotIndex<INDEX_BUCKETS> SlotIndex;
+    
+    // Bits in slotFlags_
+    static constexpr uint8_t SLOT_ACTIVE = 0x01;     // Published; scanned by checkHealth()
+    static constexpr uint8_t SLOT_TWDT = 0x02;       // Task is subscribed to the ESP-IDF TWDT
+    static constexpr uint8_t SLOT_HEARTBEAT = 0x04;  // Entry is a heartbeat rather than a task
+    static constexpr uint8_t SLOT_MISSED = 0x08;     // missedFeeds is non-zero
+    static constexpr uint8_t SLOT_RESERVED = 0x10;   // Belongs to a static task
+    
+    static constexpr MissedCount MISSED_FEEDS_MAX = static_cast<MissedCount>(~MissedCount(0));
+    
     std::atomic<bool> initialized_;
-    uint32_t timeoutMs_;
+    std::atomic<uint32_t> timeoutMs_;
     bool panicOnTimeout_;
-    SemaphoreHandle_t taskListMutex_;
-    std::vector<TaskInfo> registeredTasks_;
+    std::atomic<TickType_t> coalesceWindowTicks_;  // 0 = coalescing disabled
+    SemaphoreHandle_t taskListMutex_;   // Serializes registry changes; created by init()
+    StaticSemaphore_t taskListMutexBuffer_;
+    
+    // The registry is a structure of arrays indexed by slot. A slot is free
+    // while its handle is nullptr. Registration takes it off the free list,
+    // fills the other arrays and then publishes the slot by storing the
+    // handle, so lock-free readers never observe a half-written entry.
+    //
+    // Hot arrays, touched by feed() and checkHealth():
+    ZeroedAtomic<TaskHandle_t> slotHandles_[MAX_TASKS];  // Owner, or heartbeat tag
+    FeedCell deadlines_[MAX_TASKS];                     // Tick after which the slot is late
+    TickType_t graceTicks_[MAX_TASKS];                  // Twice the feed interval
+    ZeroedAtomic<uint8_t> slotFlags_[MAX_TASKS];         // SLOT_* bits
+    ZeroedAtomic<uint16_t> slotGenerations_[MAX_TASKS];  // Bumped each time a slot is released
+    ZeroedAtomic<uint16_t> slotSequences_[MAX_TASKS];    // Odd while the slot is rewritten
+    // Cold arrays, only read for registration, logging and statistics.
+    // Static rather than part of the singleton so that they can be placed
+    // in external RAM (WATCHDOG_COLD_IN_PSRAM).
+    static SlotDetails slotDetails_[MAX_TASKS];
+#ifdef WATCHDOG_COMPACT_TASKINFO
+    static NameEntry names_[NAME_TABLE_SIZE];  // Changed only under taskListMutex_
+#endif
+    std::atomic<size_t> registeredCount_;
+    // One bit per slot, mirroring SLOT_MISSED, so the unhealthy count can be
+    // read without walking the flag array. Written by health passes and
+    // slot release under the slot's shard lock.
+    ZeroedAtomic<uint32_t> unhealthyMask_[HEALTH_WORDS];
+    
+    // Free slots form lock-free stacks, one per shard, threaded through
+    // nextFree_. Each head packs a 16-bit change counter above the slot
+    // number so that a pop cannot succeed against a head that was popped
+    // and pushed back.
+    ZeroedAtomic<uint16_t> nextFree_[MAX_TASKS];
     
     /**
-     * @brief Find task info by handle
+     * @brief State of one registry shard, slots [shardBegin(), shardEnd())
+     */
+    struct WATCHDOG_SLOT_ALIGN Shard {
+        SemaphoreHandle_t healthMutex;  // Health pass and slot release; created by init()
+        StaticSemaphore_t healthMutexBuffer;
+        std::atomic<uint32_t> freeHead;
+        
+        constexpr Shard() : healthMutex(nullptr), healthMutexBuffer(), freeHead(FREE_END) {}
+    };
+    Shard shards_[SHARDS];
+    
+    // Slots [0, staticTaskCount_) are reserved for static tasks and never
+    // on the free list. Changed only by init() and deinit().
+    size_t staticTaskCount_;
+    
+    // Lookup indexes, changed only under taskListMutex_
+    SlotIndex handleIndex_;  // Tasks by TaskHandle_t (heartbeats are found by id)
+    SlotIndex nameIndex_;    // Tasks and heartbeats by name hash
+    
+#ifdef WATCHDOG_REGISTRY_SNAPSHOTS
+    // Published by registration and unregistration under taskListMutex_;
+    // read without locks by getTaskInfo() and forEachTask()
+    SnapshotBuffer snapshots_;
+#endif
+    
+#if WATCHDOG_PENDING_REGISTRATIONS > 0
+    // Registrations queued before init(). pendingState_ counts the reserved
+    // entries; init() sets PENDING_CLOSED, applies them and only then sets
+    // initialized_. Registry calls made in between wait for it. deinit()
+    // reopens the queue before clearing initialized_.
+    static constexpr uint32_t PENDING_CLOSED = 0x80000000;
+    PendingRegistration pending_[PENDING_REGISTRATIONS];
+    std::atomic<uint32_t> pendingState_;
+#endif
+    
+    /**
+     * @brief Handle value that marks a slot as a heartbeat
+     *
+     * Heartbeats have no task, so they are tagged with the address of
+     * their own handle entry, a value no real task handle can take.
+     */
+    WATCHDOG_FEED_INLINE TaskHandle_t heartbeatHandle(size_t slot) {
+        return reinterpret_cast<TaskHandle_t>(&slotHandles_[slot]);
+    }
+    
+    /**
+     * @brief Find a task's slot by handle
      * @param handle Task handle to search for
-     * @return Pointer to TaskInfo or nullptr if not found
+     * @return Slot index, or NO_SLOT if not found
+     * @note Lock-free: safe to call without holding taskListMutex_. Uses
+     *       handleIndex_, and falls back to scanSlots() if the index
+     *       changes during the lookup.
+     */
+    size_t findTaskByHandle(TaskHandle_t handle);
+    
+    /**
+     * @brief Find a slot by handle with a linear scan
+     * @param handle Handle to search for
+     * @return Slot index, or NO_SLOT if not found
+     * @note Lock-free
+     */
+    size_t scanSlots(TaskHandle_t handle);
+    
+    /**
+     * @brief Find a registered task or heartbeat by name (caller holds taskListMutex_)
+     * @return Slot index, or NO_SLOT if not found
+     */
+    size_t findTaskByName(const char* name) const;
+    
+    /**
+     * @brief Add a published slot to the lookup indexes (caller holds taskListMutex_)
+     */
+    void indexSlot(size_t slot);
+    
+    /**
+     * @brief Index published slots and publish one snapshot for all of them
+     * @param slots Slots claimed by registerTaskBatch()
+     * @param count Number of entries in @p slots
+     */
+    void indexClaimedSlots(const uint16_t* slots, size_t count);
+    
+    /**
+     * @brief Remove a slot from the lookup indexes (caller holds taskListMutex_)
+     */
+    void unindexSlot(size_t slot);
+    
+    /**
+     * @brief Find the calling task's slot
+     * @param currentTask Handle of the calling task
+     * @return Slot index, or NO_SLOT if not registered
+     * @note Constant time when WATCHDOG_TLS_INDEX is enabled
+     */
+    size_t findCurrentTask(TaskHandle_t currentTask);
+    
+    /**
+     * @brief Check whether a pointer refers to one of our registry slots
+     */
+    WATCHDOG_FEED_INLINE bool isSlot(const void* ptr) const {
+        const ZeroedAtomic<TaskHandle_t>* entry = static_cast<const ZeroedAtomic<TaskHandle_t>*>(ptr);
+        return entry >= slotHandles_ && entry < slotHandles_ + MAX_TASKS;
+    }
+    
+    /**
+     * @brief Remember a task's slot in its thread-local storage
+     * @param task Task whose cache to set (nullptr = calling task)
+     * @param slot Slot to cache, or NO_SLOT to clear
+     */
+    void cacheTaskSlot(TaskHandle_t task, size_t slot);
+    
+    /**
+     * @brief Remember the calling task's slot in thread-local storage
+     * @param slot Slot to cache, or NO_SLOT to clear
+     */
+    void cacheCurrentTask(size_t slot) { cacheTaskSlot(nullptr, slot); }
+    
+    /**
+     * @brief Remove a task from tracking and from the ESP-IDF watchdog
+     * @param taskHandle Handle of the task to remove
+     * @param hint Slot believed to belong to the task (NO_SLOT = search)
+     * @param taskName Optional name for logging
+     */
+    bool removeTask(TaskHandle_t taskHandle, size_t hint, const char* taskName);
+    
+    /**
+     * @brief Unindex and release a published slot (caller holds taskListMutex_)
+     * @param slot Slot to release
+     * @param removedName Receives the slot's name for logging
+     */
+    void releaseSlot(size_t slot, char* removedName);
+    
+    /**
+     * @brief Release every published slot at once (caller holds taskListMutex_)
+     * @return Number of slots released
+     * @note Clears the lookup indexes but not the free lists; the caller
+     *       rebuilds them with resetFreeList()
+     */
+    size_t releaseAllSlots();
+    
+#ifdef WATCHDOG_REGISTRY_SNAPSHOTS
+    /**
+     * @brief Copy the registry membership into a new snapshot (caller holds taskListMutex_)
+     *
+     * Waits for readers still inside the snapshot before last.
+     */
+    void publishSnapshot();
+    
+    /**
+     * @brief Find a name in a snapshot's name index
+     */
+    size_t findSnapshotEntry(const RegistrySnapshot& snapshot, const char* name) const;
+    
+    /**
+     * @brief Read the registration a snapshot entry refers to
+     * @return false if the slot was not registered in the snapshot or has
+     *         been released since
+     */
+    bool readSnapshotEntry(const RegistrySnapshot& snapshot, size_t slot, TaskInfo& info) const;
+#else
+    void publishSnapshot() {}
+#endif
+    
+    /**
+     * @brief Outcome of deferRegistration()
+     */
+    enum DeferResult : uint8_t {
+        DEFERRED,      // Queued for init()
+        DEFER_FULL,    // Queue full; registration fails
+        DEFER_CLOSED,  // init() has run (or queueing is disabled): register directly
+    };
+    
+#if WATCHDOG_PENDING_REGISTRATIONS > 0
+    /**
+     * @brief Queue a registration of the calling task for init()
+     * @note Lock-free; usable before the registry mutex exists
+     */
+    DeferResult deferRegistration(const char* taskName, bool isCritical, uint32_t feedIntervalMs);
+    
+    /**
+     * @brief Withdraw a task's queued registrations
+     * @return true if one was withdrawn before init() applied it
+     */
+    bool cancelDeferredRegistration(TaskHandle_t task);
+    
+    /**
+     * @brief Close the queue and register its entries in one batch (called by init())
+     */
+    void applyDeferredRegistrations();
+    
+    /**
+     * @brief Check initialized_, first waiting for init() to finish if it is
+     *        applying queued registrations
+     * @return true if initialized
+     */
+    bool waitUntilInitialized();
+    
+    /**
+     * @brief Accept queued registrations again (called by deinit())
+     */
+    void reopenDeferredRegistrations() { pendingState_.store(0, std::memory_order_release); }
+#else
+    DeferResult deferRegistration(const char*, bool, uint32_t) { return DEFER_CLOSED; }
+    bool cancelDeferredRegistration(TaskHandle_t) { return false; }
+    void applyDeferredRegistrations() {}
+    bool waitUntilInitialized() { return initialized_.load(std::memory_order_acquire); }
+    void reopenDeferredRegistrations() {}
+#endif
+    
+    /**
+     * @brief Copy a slot into @p info under its sequence lock
+     * @param slot Slot to read
+     * @param generation Generation the caller found the slot registered with
+     * @return false if the slot has been released since
+     * @note Never takes a lock and never delays feeders. Retries while a
+     *       health pass or release rewrites the slot, yielding for a tick
+     *       if one is in progress.
+     */
+    bool readSlot(size_t slot, uint16_t generation, TaskInfo& info) const;
+    
+    /**
+     * @brief Open a slot's write window (caller holds the slot's shard lock)
+     *
+     * Makes the sequence odd before any of the slot's fields change, so
+     * readSlot() discards what it read meanwhile.
+     */
+    void beginSlotWrite(size_t slot) {
+        slotSequences_[slot].fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    
+    /**
+     * @brief Close the window opened by beginSlotWrite()
+     */
+    void endSlotWrite(size_t slot) {
+        slotSequences_[slot].fetch_add(1, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Set or clear a slot's bit in unhealthyMask_ (caller holds the slot's shard lock)
+     */
+    void setUnhealthy(size_t slot, bool unhealthy);
+    
+    /**
+     * @brief Name a slot was registered under
+     */
+    const char* slotName(size_t slot) const {
+#ifdef WATCHDOG_COMPACT_TASKINFO
+        return names_[slotDetails_[slot].nameRef].name;
+#else
+        return slotDetails_[slot].name;
+#endif
+    }
+    
+    /**
+     * @brief Key of a slot in nameIndex_
+     */
+    uint32_t slotNameHash(size_t slot) const {
+#ifdef WATCHDOG_COMPACT_TASKINFO
+        return WatchdogIndex::hashName(slotName(slot), MAX_TASK_NAME_LEN);
+#else
+        return slotDetails_[slot].nameHash;
+#endif
+    }
+    
+    /**
+     * @brief Expected feed interval of a slot
+     */
+    uint32_t slotIntervalMs(size_t slot) const {
+#ifdef WATCHDOG_COMPACT_TASKINFO
+        return static_cast<uint32_t>(slotDetails_[slot].feedInterval) * WATCHDOG_INTERVAL_UNIT_MS;
+#else
+        return slotDetails_[slot].feedIntervalMs;
+#endif
+    }
+    
+    /**
+     * @brief Fill a claimed slot's details
+     * @return false if the name could not be stored
      */
-    TaskInfo* findTaskByHandle(TaskHandle_t handle);
+    bool setSlotDetails(size_t slot, const char* name, bool isCritical, uint32_t feedIntervalMs);
+    
+#ifdef WATCHDOG_COMPACT_TASKINFO
+    /**
+     * @brief Find or add a name in names_ and take a reference to it (caller holds taskListMutex_)
+     * @return Entry index, or NAME_TABLE_SIZE if the table is full
+     */
+    size_t internName(const char* name);
+#endif
+    
+    /**
+     * @brief Counter of feeds skipped by coalescing for a slot
+     */
+    WATCHDOG_FEED_INLINE std::atomic<uint32_t>& coalescedFeeds(size_t slot) {
+#ifdef WATCHDOG_HOT_FEED_COUNTERS
+        return deadlines_[slot].coalescedFeeds;
+#else
+        return slotDetails_[slot].coalescedFeeds;
+#endif
+    }
+    
+    const std::atomic<uint32_t>& coalescedFeeds(size_t slot) const {
+#ifdef WATCHDOG_HOT_FEED_COUNTERS
+        return deadlines_[slot].coalescedFeeds;
+#else
+        return slotDetails_[slot].coalescedFeeds;
+#endif
+    }
     
     /**
      * @brief Update feed time for task
@@ -315,10 +1342,284 @@ private:
      */
     bool updateFeedTime(TaskHandle_t handle);
     
+    /**
+     * @brief Push a known slot's deadline out by its grace period
+     * @param slot Slot owned by the caller
+     * @param now Current tick count
+     */
+    WATCHDOG_FEED_INLINE void updateFeedTime(size_t slot, TickType_t now) {
+        deadlines_[slot].store(now + graceTicks_[slot], std::memory_order_release);
+    }
+    
+    /**
+     * @brief Push a slot's deadline out unless the fed registration has ended
+     * @param slot Slot being fed
+     * @param owner Handle the registration was made with
+     * @param generation Slot generation of the registration
+     * @param now Current tick count
+     * @return false if the registration ended during the feed; the store is then undone
+     *
+     * Checking before the store is not enough: the slot can be released and
+     * reused in between, and the stale store would then hide a stall of the
+     * new owner. A new registration makes its first deadline store after the
+     * generation bump, so an exchange that displaced it also sees the bump.
+     */
+    WATCHDOG_FEED_INLINE bool storeDeadline(size_t slot, TaskHandle_t owner, uint16_t generation,
+                                            TickType_t now) {
+        TickType_t deadline = now + graceTicks_[slot];
+        TickType_t previous = deadlines_[slot].exchange(deadline, std::memory_order_acq_rel);
+        if (slotGenerations_[slot].load(std::memory_order_acquire) == generation &&
+            slotHandles_[slot].load(std::memory_order_acquire) == owner) {
+            return true;
+        }
+        // Put back what was displaced, unless the new owner has stored since
+        deadlines_[slot].compareExchange(deadline, previous, std::memory_order_relaxed);
+        return false;
+    }
+    
+    /**
+     * @brief Body of feed(): cached-slot fast path, else feedSlow()
+     */
+    WATCHDOG_FEED_INLINE bool feedFast() noexcept;
+    
+    /**
+     * @brief Out-of-line remainder of feed() when the TLS cache misses
+     * @param currentTask Handle of the calling task (never null)
+     */
+    bool feedSlow(TaskHandle_t currentTask) noexcept;
+    
+    /**
+     * @brief Feed a known slot (shared by feed() and FeedHandle::feed())
+     * @param slot Slot owned by the calling task
+     * @param owner Handle the slot's registration was made with
+     * @param generation Slot generation of that registration
+     * @return false if the registration ended during the feed
+     */
+    WATCHDOG_FEED_INLINE bool feedSlot(size_t slot, TaskHandle_t owner, uint16_t generation) noexcept;
+    
+    /**
+     * @brief Find a registered heartbeat's slot
+     * @param id Heartbeat id
+     * @return Slot index, or NO_SLOT if @p id is not a registered heartbeat
+     *         or belongs to an earlier use of the slot
+     * @note Lock-free and ISR-safe
+     */
+    WATCHDOG_FEED_INLINE size_t findHeartbeat(HeartbeatId id) {
+        size_t slot = id & 0xFFFF;
+        if (slot >= MAX_TASKS ||
+            slotGenerations_[slot].load(std::memory_order_relaxed) != (id >> 16)) {
+            return NO_SLOT;
+        }
+        return (slotHandles_[slot].load(std::memory_order_acquire) == heartbeatHandle(slot)) ?
+               slot : NO_SLOT;
+    }
+    
+    /**
+     * @brief Take taskListMutex_
+     * @return false if not taken, including before the first init()
+     */
+    bool lockRegistry(TickType_t timeout) const {
+        return taskListMutex_ && xSemaphoreTake(taskListMutex_, timeout) == pdTRUE;
+    }
+    
+    /**
+     * @brief Take a shard's health lock (after taskListMutex_, if both are needed)
+     * @return false if not taken, including before the first init()
+     */
+    bool lockShard(size_t shard, TickType_t timeout) const {
+        SemaphoreHandle_t mutex = shards_[shard].healthMutex;
+        return mutex && xSemaphoreTake(mutex, timeout) == pdTRUE;
+    }
+    
+    static constexpr size_t SHARD_SLOTS = (MAX_TASKS + SHARDS - 1) / SHARDS;
+    static constexpr size_t shardOf(size_t slot) { return slot / SHARD_SLOTS; }
+    static constexpr size_t shardBegin(size_t shard) {
+        return (shard * SHARD_SLOTS < MAX_TASKS) ? shard * SHARD_SLOTS : MAX_TASKS;
+    }
+    static constexpr size_t shardEnd(size_t shard) { return shardBegin(shard + 1); }
+    
+    // Slots checkShardHealth() scans per lock hold; bounds its stack use
+    static constexpr size_t HEALTH_BATCH = 16;
+    // Tasks registerTasks() indexes per lock hold; bounds its stack use
+    static constexpr size_t REGISTER_BATCH = 16;
+    
+    /**
+     * @brief Shard for a new registration: the owner's core affinity, or
+     *        the calling core for unpinned tasks and heartbeats
+     */
+    static size_t shardFor(TaskHandle_t owner);
+    
+    /**
+     * @brief Health pass over one shard; see checkCoreHealth()
+     */
+    size_t checkShardHealth(size_t shard);
+    
+    /**
+     * @brief Put slots [first, MAX_TASKS) on their shards' free lists, in order
+     * @note Only while no registration can run (construction, init, deinit)
+     */
+    void resetFreeList(size_t first);
+    
+    /**
+     * @brief Implementation of both init() overloads
+     */
+    bool initWithStaticTasks(uint32_t timeoutSeconds, bool panicOnTimeout,
+                             const StaticTaskSpec* tasks, size_t count);
+    
+    /**
+     * @brief Fill the slots of static tasks and take them off the free list
+     * @return false if a task's interval does not fit the timeout or its
+     *         name cannot be stored
+     */
+    bool reserveStaticSlots(const StaticTaskSpec* tasks, size_t count);
+    
+    /**
+     * @brief Return unbound static slots to the free list (caller holds taskListMutex_)
+     */
+    void clearStaticSlots();
+    
+    /**
+     * @brief Subscribe a task to the ESP-IDF TWDT unless it already is
+     * @param task Task to subscribe
+     * @param name Name for logging
+     * @param added Set to true if this call subscribed the task
+     * @return false on ESP-IDF error
+     */
+    bool subscribeToTwdt(TaskHandle_t task, const char* name, bool& added);
+    
+    /**
+     * @brief Publish the current task in its reserved slot
+     * @return Slot, or NO_SLOT on failure
+     */
+    size_t bindStaticSlot(size_t index);
+    
+    /**
+     * @brief Take a slot off a shard's free list, borrowing from the other
+     *        shards when it is empty
+     * @return Slot index, or NO_SLOT if none is free
+     * @note Lock-free
+     */
+    size_t popFreeSlot(size_t shard);
+    
+    /**
+     * @brief Return a released slot to its shard's free list
+     * @note Lock-free
+     */
+    void pushFreeSlot(size_t slot);
+    
+    /**
+     * @brief Claim, fill, publish and index a free slot
+     * @param owner Task handle, or nullptr for a heartbeat
+     * @return Claimed slot, or NO_SLOT if the registry is full
+     * @note The claim pops the lock-free free list, so it takes constant
+     *       time and concurrent callers always get distinct slots;
+     *       taskListMutex_ is taken briefly for indexing
+     */
+    size_t claimSlot(TaskHandle_t owner, const char* name, bool isCritical,
+                     uint32_t feedIntervalMs, bool twdtSubscribed);
+    
+    /**
+     * @brief Claim, fill and publish a free slot, leaving the indexing to the caller
+     * @return Claimed slot, or NO_SLOT if the registry is full
+     * @note Lock-free except for the name table with WATCHDOG_COMPACT_TASKINFO
+     */
+    size_t fillFreeSlot(TaskHandle_t owner, const char* name, bool isCritical,
+                        uint32_t feedIntervalMs, bool twdtSubscribed);
+    
+    /**
+     * @brief Body of registerTasks(), also used by init() before initialized_ is set
+     */
+    size_t registerTaskBatch(const TaskRegistration* tasks, size_t count);
+    
+    /**
+     * @brief Register current task and return its slot
+     * @return Slot of the registered task, or NO_SLOT on failure
+     */
+    size_t registerCurrentTaskSlot(const char* taskName, bool isCritical,
+                                   uint32_t feedIntervalMs);
+    
     /**
      * @brief ESP-IDF version-specific initialization
      */
     esp_err_t initWatchdogESPIDF();
 };
 
-#endif // WATCHDOG_H
\ No newline at end of file
+WATCHDOG_FEED_INLINE bool Watchdog::feedSlot(size_t slot, TaskHandle_t owner,
+                                              uint16_t generation) noexcept {
+    TickType_t now = xTaskGetTickCount();
+    
+    // Opt-in coalescing: a feed shortly after the last recorded one adds
+    // nothing, so skip the store and the IDF call entirely. The window is
+    // global; a slot whose feed interval (half its grace period) is not
+    // longer than the window is never coalesced, or it could miss a deadline.
+    TickType_t window = coalesceWindowTicks_.load(std::memory_order_relaxed);
+    if (window != 0 && window < graceTicks_[slot] / 2) {
+        TickType_t lastFeed = deadlines_[slot].load(std::memory_order_relaxed) - graceTicks_[slot];
+        if (now - lastFeed < window) {
+            // Only the owning task writes this counter, so no read-modify-write is needed
+            std::atomic<uint32_t>& coalesced = coalescedFeeds(slot);
+            coalesced.store(coalesced.load(std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+            return true;
+        }
+    }
+    if (!storeDeadline(slot, owner, generation, now)) {
+        return false;
+    }
+    
+    // Subscription state was recorded at registration, so there is no need
+    // for esp_task_wdt_status() (a second walk of the TWDT subscriber list),
+    // and unsubscribed tasks never hit the noisy "task not found" error log
+    bool subscribed = (slotFlags_[slot].load(std::memory_order_relaxed) & SLOT_TWDT) != 0;
+#ifdef WATCHDOG_FEED_IN_IRAM
+    // esp_task_wdt_reset() is in flash; defer it while the cache is off
+    if (subscribed && spi_flash_cache_enabled()) {
+#else
+    if (subscribed) {
+#endif
+        esp_task_wdt_reset();
+    }
+    return true;
+}
+
+WATCHDOG_FEED_INLINE bool Watchdog::feedFast() noexcept {
+    TaskHandle_t currentTask = xTaskGetCurrentTaskHandle();
+    // Before the scheduler starts there is no task, and no TLS to read
+    if (!currentTask) {
+        return false;
+    }
+#if WATCHDOG_TLS_INDEX >= 0
+    // Fast path: cached slot still owned by this task
+    void* cached = pvTaskGetThreadLocalStoragePointer(nullptr, WATCHDOG_TLS_INDEX);
+    if (isSlot(cached)) {
+        ZeroedAtomic<TaskHandle_t>* entry = static_cast<ZeroedAtomic<TaskHandle_t>*>(cached);
+        if (entry->load(std::memory_order_acquire) == currentTask) {
+            size_t slot = static_cast<size_t>(entry - slotHandles_);
+            return feedSlot(slot, currentTask,
+                            slotGenerations_[slot].load(std::memory_order_acquire));
+        }
+    }
+#endif
+    return feedSlow(currentTask);
+}
+
+// std::is_trivially_destructible would reject the private destructor
+static_assert(__has_trivial_destructor(Watchdog),
+              "The Watchdog singleton must not need an exit-time destructor");
+
+inline bool Watchdog::FeedHandle::isValid() const noexcept {
+    return watchdog_ &&
+           watchdog_->slotHandles_[slot_].load(std::memory_order_relaxed) == task_ &&
+           watchdog_->slotGenerations_[slot_].load(std::memory_order_relaxed) == generation_;
+}
+
+inline bool Watchdog::FeedHandle::feed() noexcept {
+    // Handle and generation guard against the slot being released or reused
+    if (!isValid()) {
+        return false;
+    }
+    // feedSlot() checks again after its store, in case the slot is reused meanwhile
+    return watchdog_->feedSlot(slot_, task_, generation_);
+}
+
+#endif // WATCHDOG_H
@@ -0,0 +1,150 @@
+/**
+ * @file WatchdogConfig.h
+ * @brief Compile-time configuration for Watchdog library
+ *
+ * All options can be overridden from build flags, e.g.
+ * @code
+ * build_flags = -DWATCHDOG_MAX_TASKS=32
+ * @endcode
+ */
+
+#ifndef WATCHDOG_CONFIG_H
+#define WATCHDOG_CONFIG_H
+
+#include <freertos/FreeRTOS.h>
+
+// Number of task slots in the registry. Slots never move, which is what
+// allows feed() to update its slot without taking the registry mutex.
+#ifndef WATCHDOG_MAX_TASKS
+    #define WATCHDOG_MAX_TASKS 16
+#endif
+
+// FreeRTOS thread-local storage index used to cache each task's registry
+// slot, making the caller lookup in feed() constant time. ESP-IDF pthread
+// support owns index 0, so the cache is only enabled by default when
+// CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS >= 2, and then uses the last
+// user index. The default is derived from the sdkconfig option rather than
+// configNUM_THREAD_LOCAL_STORAGE_POINTERS: with TLSP deletion callbacks
+// (the default from ESP-IDF 5.1) the latter is twice as large and its upper
+// half holds the callbacks. Define as -1 to disable, or pick a free index
+// below CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS explicitly.
+// NOTE: stock ESP-IDF and Arduino-ESP32 sdkconfigs set that option to 1, so
+// the cache (and the inline feed() fast path) is off until it is raised to 2.
+#ifndef WATCHDOG_TLS_INDEX
+    #if defined(CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS) && \
+        CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS > 1
+        #define WATCHDOG_TLS_INDEX (CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS - 1)
+    #else
+        #define WATCHDOG_TLS_INDEX -1
+    #endif
+#endif
+
+// Number of registry shards. The slot table is split into this many
+// contiguous ranges; a task is given a slot in the shard of the core it is
+// pinned to (unpinned tasks and heartbeats: the core they register from),
+// and each shard has its own free list and health-scan lock, so the cores
+// can run health passes in parallel (Watchdog::checkCoreHealth()). A full
+// shard borrows slots from the others.
+#ifndef WATCHDOG_CORE_SHARDS
+    #define WATCHDOG_CORE_SHARDS portNUM_PROCESSORS
+#endif
+
+// WATCHDOG_FEED_IN_IRAM: when defined, feed() becomes an out-of-line
+// function and, together with feedFromISR(), feedHeartbeat() and the
+// lookups they use, is placed in IRAM. They keep working while the SPI flash cache is disabled
+// (NVS/OTA writes). The registry they touch is already in internal DRAM
+// (.bss). While the cache is off, esp_task_wdt_reset() (which lives in
+// flash) is skipped; the slot update is still recorded and the next feed
+// resets the TWDT. The small helpers these functions call are marked
+// WATCHDOG_FEED_INLINE, which forces them inline in this mode; otherwise
+// the compiler may emit them out of line, in flash.
+#ifdef WATCHDOG_FEED_IN_IRAM
+    #include <esp_attr.h>
+    #define WATCHDOG_IRAM_ATTR IRAM_ATTR
+    #define WATCHDOG_FEED_INLINE inline __attribute__((always_inline))
+#else
+    #define WATCHDOG_IRAM_ATTR
+    #define WATCHDOG_FEED_INLINE inline
+#endif
+
+// WATCHDOG_CACHE_ALIGNED_SLOTS: when defined, each slot's feed state (its
+// deadline and coalesced feed counter) gets a cache line of its own, so
+// tasks feeding from different cores never write to the same line. This
+// only pays off where registry data is cached: host builds, or targets whose
+// internal RAM sits behind a data cache. The classic ESP32 and ESP32-S3 do
+// not cache internal SRAM, so there it just costs
+// (WATCHDOG_CACHE_LINE_SIZE - 4) bytes per slot.
+#ifndef WATCHDOG_CACHE_LINE_SIZE
+    #define WATCHDOG_CACHE_LINE_SIZE 64
+#endif
+
+#ifdef WATCHDOG_CACHE_ALIGNED_SLOTS
+    #define WATCHDOG_SLOT_ALIGN alignas(WATCHDOG_CACHE_LINE_SIZE)
+#else
+    #define WATCHDOG_SLOT_ALIGN
+#endif
+
+// WATCHDOG_COLD_IN_PSRAM: when defined, the cold registry arrays (names,
+// intervals and missed feed counts) are placed in external RAM, leaving
+// only the state touched by feed() and the health scan in internal SRAM.
+// Needs CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY; without it the arrays
+// stay internal. The coalesced feed counter moves to the hot side, since
+// the IRAM feed path must not touch PSRAM while the cache is disabled.
+#ifdef WATCHDOG_COLD_IN_PSRAM
+    #include <esp_attr.h>
+    #if !CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY
+        #warning "WATCHDOG_COLD_IN_PSRAM needs CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY; cold registry stays in internal RAM"
+    #endif
+    #if defined(EXT_RAM_BSS_ATTR)
+        #define WATCHDOG_COLD_ATTR EXT_RAM_BSS_ATTR
+    #else
+        #define WATCHDOG_COLD_ATTR EXT_RAM_ATTR  // ESP-IDF v4.x
+    #endif
+#else
+    #define WATCHDOG_COLD_ATTR
+#endif
+
+// Coalesced feed counters are written by feed(), so they live next to the
+// deadline unless the cold array is plain internal RAM
+#if defined(WATCHDOG_CACHE_ALIGNED_SLOTS) || defined(WATCHDOG_COLD_IN_PSRAM)
+    #define WATCHDOG_HOT_FEED_COUNTERS
+#endif
+
+// WATCHDOG_COMPACT_TASKINFO: when defined, the per-slot registry details
+// shrink from about 36 to 12 bytes, and names move to a shared table of
+// WATCHDOG_NAME_TABLE_SIZE entries of about 18 bytes each. Entities
+// registered under the same name share one entry; registration fails while
+// the table is full. The default of one entry per slot never limits
+// registration and saves about 6 bytes per slot; a smaller table saves
+// more when names repeat. Feed intervals are stored in 16 bits of
+// WATCHDOG_INTERVAL_UNIT_MS units (rounded up; longer intervals are
+// rejected) and missed feed counts saturate at 65535.
+#ifndef WATCHDOG_NAME_TABLE_SIZE
+    #define WATCHDOG_NAME_TABLE_SIZE WATCHDOG_MAX_TASKS
+#endif
+
+#ifndef WATCHDOG_INTERVAL_UNIT_MS
+    #define WATCHDOG_INTERVAL_UNIT_MS 10
+#endif
+
+// Number of registerCurrentTask() calls made before init() that are queued
+// and applied by init() in one batch, so tasks can start before the
+// watchdog is initialized. Entries withdrawn by unregisterCurrentTask() are
+// reused. Each entry costs about 28 bytes on the ESP32,
+// included in Watchdog::REGISTRY_BYTES. Define as 0 to make registration
+// before init() fail instead.
+#ifndef WATCHDOG_PENDING_REGISTRATIONS
+    #define WATCHDOG_PENDING_REGISTRATIONS ((WATCHDOG_MAX_TASKS + 1) / 2)
+#endif
+
+// WATCHDOG_REGISTRY_SNAPSHOTS: when defined, registration and
+// unregistration publish an immutable copy of the registry membership, and
+// getTaskInfo() and forEachTask() read it without taking the registry
+// mutex. Two copies are kept; publishing waits for readers still inside
+// the older one. Costs about 56 bytes per slot on the ESP32 (900 bytes for
+// 16 slots), included in Watchdog::REGISTRY_BYTES.
+
+// WATCHDOG_DISABLED: when defined, AppWatchdog (WatchdogStatic.h) uses the
+// null backend and all monitoring calls through it compile to nothing.
+
+#endif // WATCHDOG_CONFIG_H
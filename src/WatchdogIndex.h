@@ -0,0 +1,232 @@
+/**
+ * @file WatchdogIndex.h
+ * @brief Open-addressing index from a hashed key to a registry slot
+ *
+ * Used by Watchdog to find slots by task handle and by name in constant
+ * expected time. Free of FreeRTOS and ESP-IDF dependencies so it can be
+ * benchmarked on the host (see example/scan_benchmark).
+ */
+
+#ifndef WATCHDOG_INDEX_H
+#define WATCHDOG_INDEX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Lookups are forced inline so that they end up wherever their caller is
+// placed (IRAM with WATCHDOG_FEED_IN_IRAM)
+#if defined(__GNUC__)
+    #define WATCHDOG_INDEX_INLINE inline __attribute__((always_inline))
+#else
+    #define WATCHDOG_INDEX_INLINE inline
+#endif
+
+namespace WatchdogIndex {
+
+/**
+ * @brief Number of buckets for @p slots entries: a power of two, at least twice @p slots
+ */
+constexpr size_t bucketsFor(size_t slots, size_t buckets = 2) {
+    return (buckets >= 2 * slots) ? buckets : bucketsFor(slots, buckets * 2);
+}
+
+/**
+ * @brief Hash a pointer-sized key such as a TaskHandle_t
+ */
+WATCHDOG_INDEX_INLINE uint32_t hashPointer(const void* ptr) {
+    uintptr_t value = reinterpret_cast<uintptr_t>(ptr);
+    return static_cast<uint32_t>(value ^ (value >> 16));
+}
+
+/**
+ * @brief FNV-1a hash of a name of at most @p maxLen characters
+ */
+inline uint32_t hashName(const char* name, size_t maxLen) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < maxLen && name[i] != '\0'; i++) {
+        hash = (hash ^ static_cast<uint8_t>(name[i])) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @class SlotIndex
+ * @brief Linear-probing hash table of slot numbers
+ * @tparam Buckets Table size, a power of two (see bucketsFor())
+ *
+ * The table stores only slot numbers; keys stay in the registry, and every
+ * candidate is checked by the caller's match function. Deletion shifts
+ * later entries back instead of leaving tombstones, so probe sequences
+ * never grow with churn.
+ *
+ * Writers must be serialized externally. Readers may run concurrently:
+ * a sequence counter, bumped around every change, tells them when a
+ * result cannot be trusted.
+ *
+ * Buckets hold slot + 1, so an all-zero table is empty and a SlotIndex
+ * in static storage needs no runtime construction.
+ */
+template <size_t Buckets>
+class SlotIndex {
+public:
+    static constexpr uint16_t EMPTY = 0xFFFF;  // Returned by lookups that find nothing
+    static_assert((Buckets & (Buckets - 1)) == 0 && Buckets >= 2,
+                  "Bucket count must be a power of two");
+
+    constexpr SlotIndex() : table_(), sequence_(0) {}
+
+    /**
+     * @brief Find a slot under the writers' lock
+     * @param hash Hash of the key
+     * @param match Returns true if a candidate slot holds the key
+     * @return Slot number, or EMPTY if not found
+     */
+    template <typename Match>
+    WATCHDOG_INDEX_INLINE uint16_t find(uint32_t hash, Match match) const {
+        size_t bucket = bucketOf(hash);
+        for (size_t probes = 0; probes < Buckets; probes++) {
+            uint16_t entry = table_[bucket].load(std::memory_order_relaxed);
+            if (entry == VACANT) {
+                break;
+            }
+            if (match(static_cast<uint16_t>(entry - 1))) {
+                return static_cast<uint16_t>(entry - 1);
+            }
+            bucket = (bucket + 1) & MASK;
+        }
+        return EMPTY;
+    }
+
+    /**
+     * @brief Find a slot without the writers' lock
+     * @param hash Hash of the key
+     * @param match Returns true if a candidate slot holds the key
+     * @param slot Set to the slot number, or EMPTY if not found
+     * @return false if a writer was active, in which case @p slot is
+     *         unreliable and the caller must fall back to a full search
+     */
+    template <typename Match>
+    WATCHDOG_INDEX_INLINE bool tryFind(uint32_t hash, Match match, uint16_t& slot) const {
+        uint32_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        slot = find(hash, match);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence_.load(std::memory_order_relaxed) == before;
+    }
+
+    /**
+     * @brief Add a slot
+     * @return false if the table is full (cannot happen when sized by bucketsFor())
+     */
+    bool insert(uint32_t hash, uint16_t slot) {
+        size_t bucket = bucketOf(hash);
+        for (size_t probes = 0; probes < Buckets; probes++) {
+            if (table_[bucket].load(std::memory_order_relaxed) == VACANT) {
+                beginWrite();
+                table_[bucket].store(static_cast<uint16_t>(slot + 1), std::memory_order_relaxed);
+                endWrite();
+                return true;
+            }
+            bucket = (bucket + 1) & MASK;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Remove a slot
+     * @param hash Hash of the slot's key
+     * @param slot Slot to remove
+     * @param hashOf Returns the key hash of any slot still in the table
+     */
+    template <typename HashOf>
+    void remove(uint32_t hash, uint16_t slot, HashOf hashOf) {
+        size_t hole = bucketOf(hash);
+        for (size_t probes = 0; ; probes++) {
+            uint16_t entry = table_[hole].load(std::memory_order_relaxed);
+            if (probes == Buckets || entry == VACANT) {
+                return;  // Not indexed
+            }
+            if (entry == slot + 1) {
+                break;
+            }
+            hole = (hole + 1) & MASK;
+        }
+
+        beginWrite();
+        // Backward-shift deletion: pull later entries of the same probe
+        // run into the hole unless that would move them before their home
+        size_t next = hole;
+        while (true) {
+            next = (next + 1) & MASK;
+            uint16_t entry = table_[next].load(std::memory_order_relaxed);
+            if (entry == VACANT) {
+                break;
+            }
+            size_t home = bucketOf(hashOf(static_cast<uint16_t>(entry - 1)));
+            bool stays = (hole <= next) ? (hole < home && home <= next)
+                                        : (hole < home || home <= next);
+            if (!stays) {
+                table_[hole].store(entry, std::memory_order_relaxed);
+                hole = next;
+            }
+        }
+        table_[hole].store(VACANT, std::memory_order_relaxed);
+        endWrite();
+    }
+
+    /**
+     * @brief Remove every slot
+     */
+    void clear() {
+        beginWrite();
+        for (size_t i = 0; i < Buckets; i++) {
+            table_[i].store(VACANT, std::memory_order_relaxed);
+        }
+        endWrite();
+    }
+
+private:
+    static constexpr size_t MASK = Buckets - 1;
+    static constexpr uint16_t VACANT = 0;  // Bucket value of an empty bucket
+
+    static constexpr unsigned bitsOf(size_t n) { return (n <= 1) ? 0 : 1 + bitsOf(n / 2); }
+
+    WATCHDOG_INDEX_INLINE static size_t bucketOf(uint32_t hash) {
+        // Fibonacci hashing: the top bits of the product are well mixed
+        return static_cast<uint32_t>(hash * 2654435769u) >> (32 - bitsOf(Buckets));
+    }
+
+    void beginWrite() {
+        sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void endWrite() {
+        sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Constant-initialized to VACANT (value-initialized std::atomic arrays
+    // are not constant expressions before C++20)
+    struct Bucket : std::atomic<uint16_t> {
+        constexpr Bucket() : std::atomic<uint16_t>(VACANT) {}
+    };
+    
+    Bucket table_[Buckets];  // Slot + 1, or VACANT
+    std::atomic<uint32_t> sequence_;  // Odd while a writer is changing the table
+};
+
+template <size_t Buckets>
+constexpr uint16_t SlotIndex<Buckets>::EMPTY;
+
+template <size_t Buckets>
+constexpr size_t SlotIndex<Buckets>::MASK;
+
+template <size_t Buckets>
+constexpr uint16_t SlotIndex<Buckets>::VACANT;
+
+} // namespace WatchdogIndex
+
+#endif // WATCHDOG_INDEX_H
@@ -0,0 +1,53 @@
+/**
+ * @file WatchdogScan.h
+ * @brief Batch deadline kernel used by Watchdog::checkHealth()
+ *
+ * Kept free of FreeRTOS and ESP-IDF dependencies so it can be built and
+ * benchmarked on the host (see example/scan_benchmark).
+ */
+
+#ifndef WATCHDOG_SCAN_H
+#define WATCHDOG_SCAN_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace WatchdogScan {
+
+/**
+ * @brief Mark every active slot whose deadline has passed, in one pass
+ * @tparam Deadline std::atomic<Tick>, or any entry with a matching load()
+ * @tparam Flag std::atomic<uint8_t>, or any entry with a matching load()
+ * @tparam Tick Unsigned tick type (TickType_t on target)
+ * @param deadlines Absolute tick by which each slot must have been fed
+ * @param flags Per-slot flag bytes, indexed as their own type
+ * @param count Number of slots
+ * @param now Current tick count
+ * @param activeMask Flag bit marking a slot as in use
+ * @param overdue Output, set to 1 for overdue slots and 0 otherwise
+ * @return Number of overdue slots
+ *
+ * Only the two hot arrays are read, sequentially. The loop body has no
+ * data-dependent branches; deadlines are compared as signed differences,
+ * so tick counter wrap-around is handled.
+ */
+template <typename Deadline, typename Flag, typename Tick>
+inline size_t markOverdue(const Deadline* deadlines, const Flag* flags, size_t count, Tick now,
+                          uint8_t activeMask, uint8_t* overdue) {
+    typedef typename std::make_signed<Tick>::type SignedTick;
+    size_t overdueCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        SignedTick late = static_cast<SignedTick>(now - deadlines[i].load(std::memory_order_relaxed));
+        uint8_t active = flags[i].load(std::memory_order_relaxed) & activeMask;
+        uint8_t isOverdue = static_cast<uint8_t>((late > 0) & (active != 0));
+        overdue[i] = isOverdue;
+        overdueCount += isOverdue;
+    }
+    return overdueCount;
+}
+
+} // namespace WatchdogScan
+
+#endif // WATCHDOG_SCAN_H
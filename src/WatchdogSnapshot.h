@@ -0,0 +1,109 @@
+/**
+ * @file WatchdogSnapshot.h
+ * @brief Two-buffer read-copy-update publication of immutable snapshots
+ *
+ * Used by Watchdog (with WATCHDOG_REGISTRY_SNAPSHOTS) so that monitor
+ * tasks can read the registry without taking its mutex. Free of FreeRTOS
+ * and ESP-IDF dependencies, like WatchdogIndex.h.
+ */
+
+#ifndef WATCHDOG_SNAPSHOT_H
+#define WATCHDOG_SNAPSHOT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace WatchdogSnapshot {
+
+/**
+ * @class DoubleBuffer
+ * @brief Publishes versions of a T that readers traverse without locks
+ * @tparam T Snapshot type; constant-initializable when value-initialized
+ *
+ * One buffer is current and never written. An update fills the other one
+ * and then makes it current. Each buffer counts the readers inside it;
+ * that count is the grace period: a buffer is only rewritten once every
+ * reader that entered it has left. Two buffers suffice because updates
+ * are serialized by the caller and wait for the previous version to be
+ * drained, so no memory is allocated or reclaimed.
+ *
+ * Readers never wait on writers and never write to the snapshot. Writers
+ * wait only for readers still inside the version before last.
+ */
+template <typename T>
+class DoubleBuffer {
+public:
+    constexpr DoubleBuffer() : buffers_(), current_(0), readers_() {}
+
+    /**
+     * @brief Enter the current snapshot
+     * @return Token to pass to get() and leave()
+     * @note Lock-free; retries only if an update is published between
+     *       reading the current buffer and registering in it
+     */
+    uint8_t enter() const {
+        while (true) {
+            uint8_t buffer = current_.load();
+            readers_[buffer].fetch_add(1);
+            if (current_.load() == buffer) {
+                return buffer;
+            }
+            readers_[buffer].fetch_sub(1);
+        }
+    }
+
+    /**
+     * @brief Snapshot held by @p token; valid until leave(token)
+     */
+    const T& get(uint8_t token) const { return buffers_[token].value; }
+
+    /**
+     * @brief Leave a snapshot entered with enter()
+     */
+    void leave(uint8_t token) const { readers_[token].fetch_sub(1, std::memory_order_release); }
+
+    /**
+     * @brief Current snapshot, for the writer (readers use enter())
+     */
+    const T& latest() const { return buffers_[current_.load(std::memory_order_relaxed)].value; }
+
+    /**
+     * @brief Start an update (callers serialize updates)
+     * @param wait Called while readers are still inside the spare buffer
+     * @return Spare buffer to fill, holding the version before last
+     */
+    template <typename Wait>
+    T& beginUpdate(Wait wait) {
+        uint8_t spare = current_.load(std::memory_order_relaxed) ^ 1;
+        while (readers_[spare].load(std::memory_order_acquire) != 0) {
+            wait();
+        }
+        return buffers_[spare].value;
+    }
+
+    /**
+     * @brief Make the buffer returned by beginUpdate() current
+     */
+    void publish() { current_.store(current_.load(std::memory_order_relaxed) ^ 1); }
+
+private:
+    // Elements with their own constexpr constructors: before C++20, value-
+    // initializing an array (of T or of std::atomic) is not a constant
+    // expression, and the owning singleton must stay constant-initialized
+    struct Buffer {
+        T value;
+        constexpr Buffer() : value() {}
+    };
+    struct Counter : std::atomic<uint32_t> {
+        constexpr Counter() : std::atomic<uint32_t>(0) {}
+    };
+
+    Buffer buffers_[2];
+    std::atomic<uint8_t> current_;
+    mutable Counter readers_[2];
+};
+
+} // namespace WatchdogSnapshot
+
+#endif // WATCHDOG_SNAPSHOT_H
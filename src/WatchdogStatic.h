@@ -0,0 +1,132 @@
+/**
+ * @file WatchdogStatic.h
+ * @brief Compile-time selected watchdog front-end
+ *
+ * IWatchdog costs a virtual call per feed(), even when the implementation
+ * is NullWatchdog. StaticWatchdog picks its backend at compile time, so
+ * every call inlines; with the null backend the calls compile to nothing.
+ * The runtime IWatchdog interface remains available for dependency
+ * injection.
+ *
+ * @code
+ * // -DWATCHDOG_DISABLED removes all monitoring code and RAM
+ * void myTask(void* params) {
+ *     AppWatchdog::registerCurrentTask("MyTask");
+ *     while (true) {
+ *         AppWatchdog::feed();
+ *         vTaskDelay(pdMS_TO_TICKS(1000));
+ *     }
+ * }
+ * @endcode
+ */
+
+#ifndef WATCHDOG_STATIC_H
+#define WATCHDOG_STATIC_H
+
+#include "Watchdog.h"
+
+/**
+ * @brief Backend forwarding to the Watchdog singleton
+ *
+ * Watchdog is final, so calls through Watchdog& are statically dispatched.
+ */
+struct WatchdogBackend {
+    typedef Watchdog::FeedHandle FeedHandle;
+
+    static bool init(uint32_t timeoutSeconds, bool panicOnTimeout) noexcept {
+        return Watchdog::getInstance().init(timeoutSeconds, panicOnTimeout);
+    }
+    static bool deinit() noexcept { return Watchdog::getInstance().deinit(); }
+    static bool registerCurrentTask(const char* taskName, bool isCritical,
+                                    uint32_t feedIntervalMs) noexcept {
+        return Watchdog::getInstance().registerCurrentTask(taskName, isCritical, feedIntervalMs);
+    }
+    static FeedHandle registerCurrentTaskWithHandle(const char* taskName, bool isCritical,
+                                                    uint32_t feedIntervalMs) noexcept {
+        return Watchdog::getInstance().registerCurrentTaskWithHandle(taskName, isCritical,
+                                                                     feedIntervalMs);
+    }
+    static bool unregisterCurrentTask() noexcept {
+        return Watchdog::getInstance().unregisterCurrentTask();
+    }
+    static bool feed() noexcept { return Watchdog::getInstance().feed(); }
+    static size_t checkHealth() noexcept { return Watchdog::getInstance().checkHealth(); }
+    static bool isInitialized() noexcept { return Watchdog::getInstance().isInitialized(); }
+    static uint32_t getTimeoutMs() noexcept { return Watchdog::getInstance().getTimeoutMs(); }
+    static size_t getRegisteredTaskCount() noexcept {
+        return Watchdog::getInstance().getRegisteredTaskCount();
+    }
+    static size_t getUnhealthyTaskCount() noexcept {
+        return Watchdog::getInstance().getUnhealthyTaskCount();
+    }
+};
+
+/**
+ * @brief Backend that compiles to nothing
+ *
+ * Stateless and fully inline: no object, no vtable, no RAM.
+ */
+struct NullWatchdogBackend {
+    struct FeedHandle {
+        bool feed() noexcept { return true; }
+        void reset() noexcept {}
+        bool isValid() const noexcept { return true; }
+        explicit operator bool() const noexcept { return true; }
+    };
+
+    static bool init(uint32_t, bool) noexcept { return true; }
+    static bool deinit() noexcept { return true; }
+    static bool registerCurrentTask(const char*, bool, uint32_t) noexcept { return true; }
+    static FeedHandle registerCurrentTaskWithHandle(const char*, bool, uint32_t) noexcept {
+        return FeedHandle();
+    }
+    static bool unregisterCurrentTask() noexcept { return true; }
+    static bool feed() noexcept { return true; }
+    static size_t checkHealth() noexcept { return 0; }
+    static bool isInitialized() noexcept { return true; }
+    static uint32_t getTimeoutMs() noexcept { return 0; }
+    static size_t getRegisteredTaskCount() noexcept { return 0; }
+    static size_t getUnhealthyTaskCount() noexcept { return 0; }
+};
+
+/**
+ * @class StaticWatchdog
+ * @brief Statically dispatched watchdog front-end
+ * @tparam Backend WatchdogBackend, NullWatchdogBackend or a test mock
+ *
+ * A mock backend only needs the static functions the code under test
+ * actually calls; members of a class template are instantiated on use.
+ */
+template <typename Backend>
+class StaticWatchdog {
+public:
+    typedef typename Backend::FeedHandle FeedHandle;
+
+    static bool init(uint32_t timeoutSeconds = 30, bool panicOnTimeout = true) noexcept {
+        return Backend::init(timeoutSeconds, panicOnTimeout);
+    }
+    static bool deinit() noexcept { return Backend::deinit(); }
+    static bool registerCurrentTask(const char* taskName, bool isCritical = true,
+                                    uint32_t feedIntervalMs = 0) noexcept {
+        return Backend::registerCurrentTask(taskName, isCritical, feedIntervalMs);
+    }
+    static FeedHandle registerCurrentTaskWithHandle(const char* taskName, bool isCritical = true,
+                                                    uint32_t feedIntervalMs = 0) noexcept {
+        return Backend::registerCurrentTaskWithHandle(taskName, isCritical, feedIntervalMs);
+    }
+    static bool unregisterCurrentTask() noexcept { return Backend::unregisterCurrentTask(); }
+    static bool feed() noexcept { return Backend::feed(); }
+    static size_t checkHealth() noexcept { return Backend::checkHealth(); }
+    static bool isInitialized() noexcept { return Backend::isInitialized(); }
+    static uint32_t getTimeoutMs() noexcept { return Backend::getTimeoutMs(); }
+    static size_t getRegisteredTaskCount() noexcept { return Backend::getRegisteredTaskCount(); }
+    static size_t getUnhealthyTaskCount() noexcept { return Backend::getUnhealthyTaskCount(); }
+};
+
+#ifdef WATCHDOG_DISABLED
+    typedef StaticWatchdog<NullWatchdogBackend> AppWatchdog;
+#else
+    typedef StaticWatchdog<WatchdogBackend> AppWatchdog;
+#endif
+
+#endif // WATCHDOG_STATIC_H
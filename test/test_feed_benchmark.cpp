@@ -0,0 +1,284 @@
+/**
+ * @file test_feed_benchmark.cpp
+ * @brief Cycle counts for the different ways of feeding the watchdog
+ *
+ * Results are printed over Serial. Cycle counts vary with the build, the
+ * clock and cache state, so assertions only use bounds loose enough to
+ * hold on any target.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Watchdog.h>
+#include <WatchdogStatic.h>
+
+static const uint32_t ITERATIONS = 20000;
+
+template <typename Fn>
+static uint32_t averageCycles(Fn fn) {
+    // Warm up caches and branch state
+    for (uint32_t i = 0; i < 100; i++) {
+        fn();
+    }
+    uint32_t start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        fn();
+    }
+    return (ESP.getCycleCount() - start) / ITERATIONS;
+}
+
+struct FeedCosts {
+    uint32_t virtualCall;
+    uint32_t inlineFeed;
+    uint32_t quickFeed;
+    uint32_t feedHandle;
+};
+
+static FeedCosts measureFeedCosts(Watchdog::FeedHandle& handle) {
+    Watchdog& wd = Watchdog::getInstance();
+    IWatchdog& iface = wd;
+    FeedCosts costs;
+    // Through the interface: vtable load plus out-of-line call
+    costs.virtualCall = averageCycles([&iface]() { iface.feed(); });
+    costs.inlineFeed = averageCycles([&wd]() { wd.feed(); });
+    costs.quickFeed = averageCycles([]() { Watchdog::quickFeed(); });
+    costs.feedHandle = averageCycles([&handle]() { handle.feed(); });
+    return costs;
+}
+
+static void printFeedCosts(const char* label, const FeedCosts& costs) {
+    Serial.printf("%s: virtual %lu, inline %lu, quickFeed %lu, FeedHandle %lu cycles\n",
+                  label, costs.virtualCall, costs.inlineFeed, costs.quickFeed,
+                  costs.feedHandle);
+}
+
+void test_benchmark_feed_paths() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    Watchdog::FeedHandle handle = wd.registerCurrentTaskWithHandle("Bench", false, 1000);
+    TEST_ASSERT_TRUE(handle.isValid());
+
+    // Full feeds, dominated by esp_task_wdt_reset()
+    FeedCosts full = measureFeedCosts(handle);
+    printFeedCosts("Full feed", full);
+
+    // Coalesced feeds isolate dispatch and lookup cost
+    TEST_ASSERT_TRUE(wd.setFeedCoalescing(1000));
+    FeedCosts coalesced = measureFeedCosts(handle);
+    printFeedCosts("Coalesced feed", coalesced);
+    TEST_ASSERT_TRUE(wd.setFeedCoalescing(0));
+
+    uint32_t disabled = averageCycles([]() { StaticWatchdog<NullWatchdogBackend>::feed(); });
+    Serial.printf("Disabled (NullWatchdogBackend): %lu cycles\n", disabled);
+
+    // The ordering between the paths is reported, not asserted; only check
+    // that a coalesced feed is cheaper than one that reaches the TWDT
+    TEST_ASSERT_TRUE(coalesced.virtualCall < full.virtualCall);
+    TEST_ASSERT_TRUE(coalesced.inlineFeed < full.inlineFeed);
+    TEST_ASSERT_TRUE(coalesced.feedHandle < full.feedHandle);
+
+    handle.reset();
+    wd.deinit();
+}
+
+// Reading this flash-resident table through the cache evicts any
+// flash-resident feed code, simulating a task that just ran other code
+static const uint8_t EVICTION_BUFFER[64 * 1024] = {1};
+
+static void evictFlashCache() {
+    volatile uint32_t sink = 0;
+    for (size_t i = 0; i < sizeof(EVICTION_BUFFER); i += 32) {
+        sink += EVICTION_BUFFER[i];
+    }
+    (void)sink;
+}
+
+template <typename Fn>
+static uint32_t coldCycles(Fn fn) {
+    const uint32_t trials = 200;
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < trials; i++) {
+        evictFlashCache();
+        uint32_t start = ESP.getCycleCount();
+        fn();
+        total += ESP.getCycleCount() - start;
+    }
+    return total / trials;
+}
+
+void test_benchmark_cold_cache_feed() {
+    Watchdog& wd = Watchdog::getInstance();
+    IWatchdog& iface = wd;
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("Cold", false, 1000));
+    Watchdog::HeartbeatId heartbeat = wd.registerHeartbeat("ColdHb", 1000);
+
+    // Out-of-line paths, IRAM-resident with WATCHDOG_FEED_IN_IRAM
+    uint32_t feedWarm = averageCycles([&iface]() { iface.feed(); });
+    uint32_t feedCold = coldCycles([&iface]() { iface.feed(); });
+    uint32_t heartbeatWarm = averageCycles([&wd, heartbeat]() { wd.feedHeartbeat(heartbeat); });
+    uint32_t heartbeatCold = coldCycles([&wd, heartbeat]() { wd.feedHeartbeat(heartbeat); });
+
+#ifdef WATCHDOG_FEED_IN_IRAM
+    const char* placement = "IRAM";
+#else
+    const char* placement = "flash";
+#endif
+    Serial.printf("Feed path in %s: feed() warm %lu / cold %lu, "
+                  "feedHeartbeat() warm %lu / cold %lu cycles\n",
+                  placement, feedWarm, feedCold, heartbeatWarm, heartbeatCold);
+    // Reported only: miss costs depend on the flash chip and clock, and
+    // feed() still reaches esp_task_wdt_reset() in flash
+    Serial.println("Build once with and once without -DWATCHDOG_FEED_IN_IRAM "
+                   "to compare the cold-cache counts");
+
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(heartbeat));
+    wd.deinit();
+}
+
+static const uint32_t DUAL_CORE_FEEDS = 200000;
+static volatile uint32_t dualCoreCycles[2];
+static volatile int dualCoreDone = 0;
+
+static void dualCoreFeeder(void* param) {
+    int core = reinterpret_cast<intptr_t>(param);
+    Watchdog::FeedHandle handle =
+        Watchdog::getInstance().registerCurrentTaskWithHandle("Dual", false, 1000);
+    // Wait for both feeders so their slots are claimed back to back
+    while (Watchdog::getInstance().getRegisteredTaskCount() < 2) {
+        vTaskDelay(1);
+    }
+    uint32_t start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < DUAL_CORE_FEEDS; i++) {
+        handle.feed();
+    }
+    dualCoreCycles[core] = ESP.getCycleCount() - start;
+    handle.reset();
+    __atomic_fetch_add(&dualCoreDone, 1, __ATOMIC_RELEASE);
+    vTaskDelete(nullptr);
+}
+
+void test_benchmark_dual_core_feeds() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    // Coalesced feeds write only the slot, not the TWDT's shared state
+    TEST_ASSERT_TRUE(wd.setFeedCoalescing(1000));
+
+    dualCoreDone = 0;
+    xTaskCreatePinnedToCore(dualCoreFeeder, "Dual0", 4096, reinterpret_cast<void*>(0), 5,
+                            nullptr, 0);
+    xTaskCreatePinnedToCore(dualCoreFeeder, "Dual1", 4096, reinterpret_cast<void*>(1), 5,
+                            nullptr, 1);
+    while (__atomic_load_n(&dualCoreDone, __ATOMIC_ACQUIRE) < 2) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+#ifdef WATCHDOG_CACHE_ALIGNED_SLOTS
+    const char* layout = "cache-line aligned";
+#else
+    const char* layout = "packed";
+#endif
+    Serial.printf("Adjacent slots fed from both cores (%s): core 0 %lu, core 1 %lu cycles/feed\n",
+                  layout, dualCoreCycles[0] / DUAL_CORE_FEEDS,
+                  dualCoreCycles[1] / DUAL_CORE_FEEDS);
+
+    TEST_ASSERT_TRUE(wd.setFeedCoalescing(0));
+    wd.deinit();
+}
+
+static const size_t BOOT_TASKS = 8;
+static const uint32_t BOOT_REGISTER = 1;
+static const uint32_t BOOT_UNREGISTER = 2;
+
+static TaskHandle_t bootCoordinator = nullptr;
+static volatile uint32_t bootCallUs = 0;
+static volatile bool bootCallOk = false;
+
+// Feeds like a real worker, so its TWDT subscription never expires. On
+// command it registers or unregisters itself and reports how long that took.
+static void bootWorker(void*) {
+    Watchdog& wd = Watchdog::getInstance();
+    while (true) {
+        uint32_t command = 0;
+        if (xTaskNotifyWait(0, UINT32_MAX, &command, pdMS_TO_TICKS(100)) == pdTRUE) {
+            uint32_t start = micros();
+            bool ok = (command == BOOT_REGISTER) ? wd.registerCurrentTask("Boot", false, 1000) :
+                                                   wd.unregisterCurrentTask();
+            bootCallUs = micros() - start;
+            bootCallOk = ok;
+            xTaskNotifyGive(bootCoordinator);
+        }
+        wd.feed();
+    }
+}
+
+// Total time of every worker running @p command on itself, one after another
+static uint32_t runOnEachWorker(const TaskHandle_t* handles, uint32_t command) {
+    uint32_t total = 0;
+    for (size_t i = 0; i < BOOT_TASKS; i++) {
+        xTaskNotify(handles[i], command, eSetValueWithOverwrite);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        TEST_ASSERT_TRUE(bootCallOk);
+        total += bootCallUs;
+    }
+    return total;
+}
+
+void test_benchmark_boot_registration() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    // The tasks a boot sequence would create and register
+    TaskHandle_t handles[BOOT_TASKS];
+    Watchdog::TaskRegistration tasks[BOOT_TASKS];
+    for (size_t i = 0; i < BOOT_TASKS; i++) {
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(bootWorker, "Boot", 2048, nullptr, 1, &handles[i]));
+        tasks[i] = {handles[i], nullptr, 1000, false};
+    }
+
+    // Each task registering itself, as without a batch: a mutex hold,
+    // snapshot and log line each. Only the calls are timed, not the handoffs.
+    bootCoordinator = xTaskGetCurrentTaskHandle();
+    uint32_t oneByOne = runOnEachWorker(handles, BOOT_REGISTER);
+    TEST_ASSERT_EQUAL(BOOT_TASKS, wd.getRegisteredTaskCount());
+    uint32_t removeOneByOne = runOnEachWorker(handles, BOOT_UNREGISTER);
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+
+    uint32_t start = micros();
+    TEST_ASSERT_EQUAL(BOOT_TASKS, wd.registerTasks(tasks, BOOT_TASKS));
+    uint32_t batch = micros() - start;
+    start = micros();
+    TEST_ASSERT_EQUAL(BOOT_TASKS, wd.unregisterTasks(handles, BOOT_TASKS));
+    uint32_t removeBatch = micros() - start;
+
+    TEST_ASSERT_EQUAL(BOOT_TASKS, wd.registerTasks(tasks, BOOT_TASKS));
+    start = micros();
+    wd.deinit();
+    uint32_t shutdown = micros() - start;
+
+    // Printed only: timings this short are at the mercy of the scheduler,
+    // so no order between them is asserted
+    Serial.printf("%u tasks: register %lu us self-registered, %lu us batched; "
+                  "unregister %lu us self-unregistered, %lu us batched; deinit %lu us\n",
+                  (unsigned)BOOT_TASKS, oneByOne, batch, removeOneByOne, removeBatch, shutdown);
+
+    for (size_t i = 0; i < BOOT_TASKS; i++) {
+        vTaskDelete(handles[i]);
+    }
+}
+
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_feed_paths);
+    RUN_TEST(test_benchmark_cold_cache_feed);
+    RUN_TEST(test_benchmark_dual_core_feeds);
+    RUN_TEST(test_benchmark_boot_registration);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_feed_latency.cpp
+ * @brief Stress test proving feed() latency stays bounded under contention
+ *
+ * A feeder pinned to core 1 times every feed() in CPU cycles, first with
+ * core 0 idle and then while core 0 runs checkHealth() against permanently
+ * late tasks (so every scan logs over the UART) and churns registrations.
+ * Interrupts are masked around each timed feed, so the numbers are the
+ * cost of feed() itself. The first run measures the uncontended worst case
+ * on the board under test, and the bound documented next to feed() is
+ * relative to it: contention may add waiting for the TWDT spinlock and
+ * cache line transfers, but nothing that grows with the other core's work.
+ * Before the lock-free feed path a feed could wait up to 10 ms for the
+ * registry mutex.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Watchdog.h>
+
+static const uint32_t FEED_ITERATIONS = 100000;
+// Bound stated with feed() in Watchdog.h: worst case under contention
+// within this factor of the uncontended worst case
+static const uint32_t MAX_CONTENTION_FACTOR = 4;
+static const int LATE_TASKS = 4;
+
+struct FeedTiming {
+    uint32_t maxCycles;
+    uint32_t totalCycles;
+};
+
+static volatile bool stopStress = false;
+static volatile bool feederDone = false;
+static FeedTiming feederTiming;
+
+static void lateTask(void*) {
+    // Registers with a tiny interval and never feeds
+    (void)Watchdog::getInstance().registerCurrentTask("Late", false, 10);
+    while (!stopStress) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    Watchdog::getInstance().unregisterCurrentTask();
+    vTaskDelete(nullptr);
+}
+
+static void healthTask(void*) {
+    while (!stopStress) {
+        (void)Watchdog::getInstance().checkHealth();
+        vTaskDelay(1);
+    }
+    vTaskDelete(nullptr);
+}
+
+static void churnTask(void*) {
+    Watchdog& wd = Watchdog::getInstance();
+    while (!stopStress) {
+        (void)wd.registerCurrentTask("Churn", false, 1000);
+        wd.unregisterCurrentTask();
+        vTaskDelay(1);
+    }
+    vTaskDelete(nullptr);
+}
+
+static void feederTask(void*) {
+    Watchdog& wd = Watchdog::getInstance();
+    (void)wd.registerCurrentTask("Feeder", false, 1000);
+
+    uint32_t maxCycles = 0;
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < FEED_ITERATIONS; i++) {
+        // Masked so that an interrupt taken mid-feed is not counted as feed() time
+        portDISABLE_INTERRUPTS();
+        uint32_t start = ESP.getCycleCount();
+        wd.feed();
+        uint32_t elapsed = ESP.getCycleCount() - start;
+        portENABLE_INTERRUPTS();
+        total += elapsed;
+        if (elapsed > maxCycles) {
+            maxCycles = elapsed;
+        }
+        if ((i % 1000) == 0) {
+            vTaskDelay(1);  // Let the idle task run
+        }
+    }
+
+    feederTiming.maxCycles = maxCycles;
+    feederTiming.totalCycles = total;
+    wd.unregisterCurrentTask();
+    feederDone = true;
+    vTaskDelete(nullptr);
+}
+
+static FeedTiming timeFeeds() {
+    feederDone = false;
+    xTaskCreatePinnedToCore(feederTask, "Feeder", 4096, nullptr, 5, nullptr, 1);
+    while (!feederDone) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    return feederTiming;
+}
+
+static void printTiming(const char* label, const FeedTiming& timing, uint32_t mhz) {
+    Serial.printf("feed() %s: avg %lu cycles, max %lu cycles (%lu us) over %lu feeds\n", label,
+                  timing.totalCycles / FEED_ITERATIONS, timing.maxCycles,
+                  timing.maxCycles / mhz, FEED_ITERATIONS);
+}
+
+void test_feed_latency_bounded_under_contention() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    uint32_t mhz = ESP.getCpuFreqMHz();
+
+    FeedTiming idle = timeFeeds();
+    printTiming("uncontended", idle, mhz);
+
+    stopStress = false;
+    for (int i = 0; i < LATE_TASKS; i++) {
+        xTaskCreatePinnedToCore(lateTask, "Late", 3072, nullptr, 1, nullptr, 0);
+    }
+    vTaskDelay(pdMS_TO_TICKS(50));
+    xTaskCreatePinnedToCore(healthTask, "Health", 4096, nullptr, 2, nullptr, 0);
+    xTaskCreatePinnedToCore(churnTask, "Churn", 3072, nullptr, 2, nullptr, 0);
+    FeedTiming contended = timeFeeds();
+    stopStress = true;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    printTiming("under contention", contended, mhz);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, idle.maxCycles);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(MAX_CONTENTION_FACTOR * idle.maxCycles,
+                                     contended.maxCycles);
+
+    wd.deinit();
+}
+
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_feed_latency_bounded_under_contention);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty
+}
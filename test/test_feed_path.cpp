@@ -0,0 +1,301 @@
+/**
+ * @file test_feed_path.cpp
+ * @brief Test the lock-free feed path of the Watchdog class
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <Watchdog.h>
+#include <WatchdogStatic.h>
+
+void test_feed_updates_last_feed_time() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("FeedTask", false, 1000));
+
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_TRUE(wd.feed());
+
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.getTaskInfo("FeedTask", info));
+    TEST_ASSERT_TRUE(xTaskGetTickCount() - info.lastFeedTime <= pdMS_TO_TICKS(5));
+    TEST_ASSERT_EQUAL(0, info.missedFeeds.load());
+
+    wd.deinit();
+}
+
+void test_feed_unregistered_task_succeeds() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    // Feeding without registration is silently accepted
+    TEST_ASSERT_TRUE(wd.feed());
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+
+
+    wd.deinit();
+}
+
+void test_feed_resets_directly_subscribed_task() {
+    Watchdog& wd = Watchdog::getInstance();
+    // Panic on timeout: a missed reset reboots the board and fails the run
+    TEST_ASSERT_TRUE(wd.init(2, true));
+
+    // loopTask may already be subscribed (CONFIG_ARDUINO_LOOP_WDT)
+    bool added = (esp_task_wdt_status(nullptr) != ESP_OK);
+    if (added) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_add(nullptr));
+    }
+    for (int i = 0; i < 10; i++) {
+        vTaskDelay(pdMS_TO_TICKS(500));  // 5s in total, past the 2s timeout
+        TEST_ASSERT_TRUE(wd.feed());
+    }
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+    if (added) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_delete(nullptr));
+    }
+
+    wd.deinit();
+}
+
+void test_slot_reused_after_unregister() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("First", false, 1000));
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("Second", false, 1000));
+    TEST_ASSERT_EQUAL(1, wd.getRegisteredTaskCount());
+
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_FALSE(wd.getTaskInfo("First", info));
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Second", info));
+
+    wd.deinit();
+}
+
+void test_cached_slot_invalidated_by_handle_unregister() {
+#if WATCHDOG_TLS_INDEX < 0
+    TEST_IGNORE_MESSAGE("TLS cache disabled: raise CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS");
+#else
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("Cached", false, 1000));
+    TEST_ASSERT_NOT_NULL(pvTaskGetThreadLocalStoragePointer(nullptr, WATCHDOG_TLS_INDEX));
+    TEST_ASSERT_TRUE(wd.unregisterTaskByHandle(xTaskGetCurrentTaskHandle()));
+
+    // Stale thread-local cache entry must not resurrect the slot
+    TEST_ASSERT_TRUE(wd.feed());
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_FALSE(wd.getTaskInfo("Cached", info));
+
+    // Re-registration refreshes the cache
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("Cached", false, 1000));
+    vTaskDelay(pdMS_TO_TICKS(20));
+    TEST_ASSERT_TRUE(wd.feed());
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Cached", info));
+    TEST_ASSERT_TRUE(xTaskGetTickCount() - info.lastFeedTime <= pdMS_TO_TICKS(5));
+
+    wd.deinit();
+#endif
+}
+
+static volatile bool cachedTaskRegistered = false;
+
+static void cachedTask(void*) {
+    cachedTaskRegistered = Watchdog::getInstance().registerCurrentTask("Deleted", false, 1000);
+    while (true) {
+        vTaskDelay(portMAX_DELAY);
+    }
+}
+
+void test_task_deleted_with_cache_entry() {
+#if WATCHDOG_TLS_INDEX < 0
+    TEST_IGNORE_MESSAGE("TLS cache disabled: raise CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS");
+#else
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    cachedTaskRegistered = false;
+    TaskHandle_t task = nullptr;
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(cachedTask, "Deleted", 3072, nullptr, 5, &task));
+    while (!cachedTaskRegistered) {
+        vTaskDelay(1);
+    }
+    TEST_ASSERT_NOT_NULL(pvTaskGetThreadLocalStoragePointer(task, WATCHDOG_TLS_INDEX));
+
+    // Unregistering by handle leaves the task's cache entry in place;
+    // vTaskDelete() must not treat it as a deletion callback
+    TEST_ASSERT_TRUE(wd.unregisterTaskByHandle(task));
+    vTaskDelete(task);
+    vTaskDelay(pdMS_TO_TICKS(50));  // Idle task frees the TCB
+
+    wd.deinit();
+#endif
+}
+
+void test_feed_coalescing() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("Coalesce", false, 1000));
+
+    // Window must stay below the default feed interval
+    TEST_ASSERT_FALSE(wd.setFeedCoalescing(wd.getTimeoutMs()));
+    TEST_ASSERT_TRUE(wd.setFeedCoalescing(100));
+
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(wd.feed());
+    }
+    TEST_ASSERT_TRUE(wd.getCoalescedFeedCount() >= 990);
+
+    // Once the window has passed the next feed is recorded again
+    vTaskDelay(pdMS_TO_TICKS(150));
+    TEST_ASSERT_TRUE(wd.feed());
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Coalesce", info));
+    TEST_ASSERT_TRUE(xTaskGetTickCount() - info.lastFeedTime <= pdMS_TO_TICKS(5));
+
+    // A task whose interval does not exceed the window is never coalesced
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("Coalesce", false, 100));
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(wd.feed());
+    }
+    TEST_ASSERT_EQUAL(0, wd.getCoalescedFeedCount());
+
+    TEST_ASSERT_TRUE(wd.setFeedCoalescing(0));
+    wd.deinit();
+}
+
+void test_feed_handle() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    {
+        Watchdog::FeedHandle handle = wd.registerCurrentTaskWithHandle("Handle", false, 1000);
+        TEST_ASSERT_TRUE(handle.isValid());
+        TEST_ASSERT_TRUE(handle.feed());
+        TEST_ASSERT_EQUAL(1, wd.getRegisteredTaskCount());
+
+        // Ownership moves with the handle
+        Watchdog::FeedHandle moved = std::move(handle);
+        TEST_ASSERT_FALSE(handle.isValid());
+        TEST_ASSERT_TRUE(moved.feed());
+    }
+
+    // Destroying the handle unregistered the task
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+
+    // A handle outliving its registration stops feeding
+    Watchdog::FeedHandle stale = wd.registerCurrentTaskWithHandle("Stale", false, 1000);
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+    TEST_ASSERT_FALSE(stale.feed());
+
+    wd.deinit();
+}
+
+static volatile Watchdog::HeartbeatId timerHeartbeat = Watchdog::INVALID_HEARTBEAT;
+static volatile size_t unhealthySeenFromTimer = 0;
+
+static void heartbeatTimerCallback(void*) {
+    Watchdog& wd = Watchdog::getInstance();
+    wd.feedFromISR(timerHeartbeat);
+    unhealthySeenFromTimer = wd.getUnhealthyTaskCount();
+}
+
+void test_heartbeat_health_accounting() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    Watchdog::HeartbeatId stalled = wd.registerHeartbeat("Stalled", 20);
+    TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, stalled);
+    timerHeartbeat = wd.registerHeartbeat("Timer", 20);
+    TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, timerHeartbeat);
+
+    // Feed one heartbeat from an esp_timer callback every 5 ms
+    esp_timer_create_args_t args = {};
+    args.callback = heartbeatTimerCallback;
+    args.name = "hb";
+    esp_timer_handle_t timer;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_timer_create(&args, &timer));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_timer_start_periodic(timer, 5000));
+
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    // Only the stalled heartbeat is late
+    TEST_ASSERT_EQUAL(1, wd.checkHealth());
+    TEST_ASSERT_EQUAL(1, wd.getUnhealthyTaskCount());
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL(1, unhealthySeenFromTimer);
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Stalled", info));
+    TEST_ASSERT_TRUE(info.isHeartbeat);
+    TEST_ASSERT_EQUAL(1, info.missedFeeds.load());
+
+    // Feeding from task context clears it
+    TEST_ASSERT_TRUE(wd.feedHeartbeat(stalled));
+    TEST_ASSERT_EQUAL(0, wd.checkHealth());
+    TEST_ASSERT_EQUAL(0, wd.getUnhealthyTaskCount());
+
+    esp_timer_stop(timer);
+    esp_timer_delete(timer);
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(stalled));
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(timerHeartbeat));
+    TEST_ASSERT_FALSE(wd.feedFromISR(stalled));
+
+    wd.deinit();
+}
+
+struct CountingBackend {
+    typedef NullWatchdogBackend::FeedHandle FeedHandle;
+    static int feeds;
+    static bool feed() noexcept { ++feeds; return true; }
+};
+int CountingBackend::feeds = 0;
+
+void test_static_front_end() {
+    // Mock backend only implements what is used
+    StaticWatchdog<CountingBackend>::feed();
+    StaticWatchdog<CountingBackend>::feed();
+    TEST_ASSERT_EQUAL(2, CountingBackend::feeds);
+
+    // Null backend is stateless and always succeeds
+    typedef StaticWatchdog<NullWatchdogBackend> Disabled;
+    TEST_ASSERT_TRUE(Disabled::registerCurrentTask("Null"));
+    TEST_ASSERT_TRUE(Disabled::feed());
+    TEST_ASSERT_EQUAL(0, Disabled::getRegisteredTaskCount());
+
+    // Real backend reaches the singleton
+    typedef StaticWatchdog<WatchdogBackend> Real;
+    TEST_ASSERT_TRUE(Real::init(10, false));
+    TEST_ASSERT_TRUE(Real::registerCurrentTask("Static", false, 1000));
+    TEST_ASSERT_TRUE(Real::feed());
+    TEST_ASSERT_EQUAL(1, Watchdog::getInstance().getRegisteredTaskCount());
+    TEST_ASSERT_TRUE(Real::deinit());
+}
+
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_feed_updates_last_feed_time);
+    RUN_TEST(test_feed_unregistered_task_succeeds);
+    RUN_TEST(test_feed_resets_directly_subscribed_task);
+    RUN_TEST(test_slot_reused_after_unregister);
+    RUN_TEST(test_cached_slot_invalidated_by_handle_unregister);
+    RUN_TEST(test_task_deleted_with_cache_entry);
+    RUN_TEST(test_feed_coalescing);
+    RUN_TEST(test_feed_handle);
+    RUN_TEST(test_heartbeat_health_accounting);
+    RUN_TEST(test_static_front_end);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty
+}
@@ -0,0 +1,775 @@
+/**
+ * @file test_registry.cpp
+ * @brief Test the fixed-capacity task registry of the Watchdog class
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <esp_heap_caps.h>
+#include <Watchdog.h>
+
+void test_registration_does_not_allocate() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    size_t freeBefore = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("NoAlloc", false, 1000));
+    Watchdog::HeartbeatId heartbeat = wd.registerHeartbeat("NoAllocHb", 1000);
+    TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, heartbeat);
+    TEST_ASSERT_TRUE(wd.feed());
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(heartbeat));
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+    TEST_ASSERT_EQUAL(freeBefore, heap_caps_get_free_size(MALLOC_CAP_DEFAULT));
+
+    wd.deinit();
+}
+
+void test_registry_full() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    Watchdog::HeartbeatId ids[Watchdog::MAX_TASKS];
+    for (size_t i = 0; i < Watchdog::MAX_TASKS; i++) {
+        ids[i] = wd.registerHeartbeat("Fill", 1000);
+        TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, ids[i]);
+    }
+    TEST_ASSERT_EQUAL(Watchdog::MAX_TASKS, wd.getRegisteredTaskCount());
+
+    // No slot left, and the failed task registration leaves no trace
+    TEST_ASSERT_EQUAL(Watchdog::INVALID_HEARTBEAT, wd.registerHeartbeat("Overflow", 1000));
+    TEST_ASSERT_FALSE(wd.registerCurrentTask("Overflow", false, 1000));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_task_wdt_status(xTaskGetCurrentTaskHandle()));
+
+    // Releasing one slot makes room again
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(ids[0]));
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("Late", false, 1000));
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+
+    for (size_t i = 1; i < Watchdog::MAX_TASKS; i++) {
+        TEST_ASSERT_TRUE(wd.unregisterHeartbeat(ids[i]));
+    }
+    wd.deinit();
+}
+
+static volatile bool lookupTaskRegistered = false;
+
+static void lookupTask(void*) {
+    (void)Watchdog::getInstance().registerCurrentTask("Lookup", false, 1000);
+    lookupTaskRegistered = true;
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+void test_lookup_by_name_and_handle() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    // Fill most of the registry so lookups have to get past other entries
+    Watchdog::HeartbeatId ids[Watchdog::MAX_TASKS - 1];
+    char name[Watchdog::MAX_TASK_NAME_LEN];
+    for (size_t i = 0; i < Watchdog::MAX_TASKS - 1; i++) {
+        snprintf(name, sizeof(name), "Hb%u", (unsigned)i);
+        ids[i] = wd.registerHeartbeat(name, 1000);
+        TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, ids[i]);
+    }
+
+    TaskHandle_t handle = nullptr;
+    lookupTaskRegistered = false;
+    xTaskCreate(lookupTask, "Lookup", 3072, nullptr, 5, &handle);
+    while (!lookupTaskRegistered) {
+        vTaskDelay(1);
+    }
+
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Lookup", info));
+    TEST_ASSERT_EQUAL_PTR(handle, info.handle.load());
+    for (size_t i = 0; i < Watchdog::MAX_TASKS - 1; i += 3) {
+        snprintf(name, sizeof(name), "Hb%u", (unsigned)i);
+        TEST_ASSERT_TRUE(wd.getTaskInfo(name, info));
+        TEST_ASSERT_TRUE(info.isHeartbeat);
+    }
+    TEST_ASSERT_FALSE(wd.getTaskInfo("Missing", info));
+
+    // Removing entries keeps the remaining ones reachable
+    for (size_t i = 0; i < Watchdog::MAX_TASKS - 1; i += 2) {
+        TEST_ASSERT_TRUE(wd.unregisterHeartbeat(ids[i]));
+    }
+    TEST_ASSERT_TRUE(wd.unregisterTaskByHandle(handle));
+    TEST_ASSERT_FALSE(wd.getTaskInfo("Lookup", info));
+    for (size_t i = 1; i < Watchdog::MAX_TASKS - 1; i += 2) {
+        snprintf(name, sizeof(name), "Hb%u", (unsigned)i);
+        TEST_ASSERT_TRUE(wd.getTaskInfo(name, info));
+        TEST_ASSERT_TRUE(wd.unregisterHeartbeat(ids[i]));
+    }
+
+    vTaskDelete(handle);
+    wd.deinit();
+}
+
+static const int CLAIM_TASKS = 4;
+static const int CLAIMS_PER_TASK = Watchdog::MAX_TASKS / CLAIM_TASKS;
+static Watchdog::HeartbeatId claimedIds[CLAIM_TASKS][CLAIMS_PER_TASK];
+static volatile int claimersDone = 0;
+
+static void claimTask(void* param) {
+    int index = reinterpret_cast<intptr_t>(param);
+    for (int i = 0; i < CLAIMS_PER_TASK; i++) {
+        claimedIds[index][i] = Watchdog::getInstance().registerHeartbeat("Claim", 1000);
+    }
+    __atomic_fetch_add(&claimersDone, 1, __ATOMIC_RELEASE);
+    vTaskDelete(nullptr);
+}
+
+void test_concurrent_claims_get_distinct_slots() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    // Claimers on both cores race for the same free slots
+    claimersDone = 0;
+    for (int i = 0; i < CLAIM_TASKS; i++) {
+        xTaskCreatePinnedToCore(claimTask, "Claim", 3072, reinterpret_cast<void*>(i),
+                                5, nullptr, i % 2);
+    }
+    while (__atomic_load_n(&claimersDone, __ATOMIC_ACQUIRE) < CLAIM_TASKS) {
+        vTaskDelay(1);
+    }
+
+    bool used[Watchdog::MAX_TASKS] = {false};
+    for (int t = 0; t < CLAIM_TASKS; t++) {
+        for (int i = 0; i < CLAIMS_PER_TASK; i++) {
+            Watchdog::HeartbeatId id = claimedIds[t][i];
+            TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, id);
+            size_t slot = id & 0xFFFF;  // Low half of the id is the slot
+            TEST_ASSERT_FALSE(used[slot]);
+            used[slot] = true;
+        }
+    }
+    TEST_ASSERT_EQUAL(CLAIM_TASKS * CLAIMS_PER_TASK, wd.getRegisteredTaskCount());
+
+    for (int t = 0; t < CLAIM_TASKS; t++) {
+        for (int i = 0; i < CLAIMS_PER_TASK; i++) {
+            TEST_ASSERT_TRUE(wd.unregisterHeartbeat(claimedIds[t][i]));
+        }
+    }
+    wd.deinit();
+}
+
+static Watchdog::HeartbeatId coreHeartbeats[2];
+static volatile int coreRegistrarsDone = 0;
+
+static void coreRegistrar(void* param) {
+    int core = reinterpret_cast<intptr_t>(param);
+    coreHeartbeats[core] = Watchdog::getInstance().registerHeartbeat(core ? "Core1" : "Core0", 50);
+    __atomic_fetch_add(&coreRegistrarsDone, 1, __ATOMIC_RELEASE);
+    vTaskDelete(nullptr);
+}
+
+void test_health_passes_per_core() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    if (Watchdog::SHARDS < 2) {
+        wd.deinit();
+        TEST_IGNORE_MESSAGE("Single-core build");
+    }
+
+    // Each heartbeat lands in the shard of the core that registered it
+    coreRegistrarsDone = 0;
+    for (int core = 0; core < 2; core++) {
+        xTaskCreatePinnedToCore(coreRegistrar, "Reg", 3072, reinterpret_cast<void*>(core),
+                                5, nullptr, core);
+    }
+    while (__atomic_load_n(&coreRegistrarsDone, __ATOMIC_ACQUIRE) < 2) {
+        vTaskDelay(1);
+    }
+    TEST_ASSERT_LESS_THAN(Watchdog::MAX_TASKS / 2, coreHeartbeats[0] & 0xFFFF);
+    TEST_ASSERT_GREATER_OR_EQUAL(Watchdog::MAX_TASKS / 2, coreHeartbeats[1] & 0xFFFF);
+
+    // Only core 1's shard holds a late heartbeat
+    vTaskDelay(pdMS_TO_TICKS(200));
+    TEST_ASSERT_TRUE(wd.feedHeartbeat(coreHeartbeats[0]));
+    TEST_ASSERT_EQUAL(0, wd.checkCoreHealth(0));
+    TEST_ASSERT_EQUAL(1, wd.checkCoreHealth(1));
+    TEST_ASSERT_EQUAL(1, wd.getUnhealthyTaskCount());
+
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(coreHeartbeats[0]));
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(coreHeartbeats[1]));
+    TEST_ASSERT_EQUAL(0, wd.getUnhealthyTaskCount());
+    wd.deinit();
+}
+
+void test_stale_ids_are_rejected() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    // A released slot is reused by the next registration, under a new id
+    Watchdog::HeartbeatId first = wd.registerHeartbeat("First", 1000);
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(first));
+    Watchdog::HeartbeatId second = wd.registerHeartbeat("Second", 1000);
+    TEST_ASSERT_EQUAL(first & 0xFFFF, second & 0xFFFF);
+    TEST_ASSERT_NOT_EQUAL(first, second);
+    TEST_ASSERT_FALSE(wd.feedHeartbeat(first));
+    TEST_ASSERT_FALSE(wd.unregisterHeartbeat(first));
+    TEST_ASSERT_TRUE(wd.feedHeartbeat(second));
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(second));
+
+    // A handle from an earlier registration of the same task goes stale
+    Watchdog::FeedHandle stale = wd.registerCurrentTaskWithHandle("Stale", false, 1000);
+    TEST_ASSERT_TRUE(stale.isValid());
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+    Watchdog::FeedHandle fresh = wd.registerCurrentTaskWithHandle("Stale", false, 1000);
+    TEST_ASSERT_TRUE(fresh.isValid());
+    TEST_ASSERT_FALSE(stale.isValid());
+    TEST_ASSERT_FALSE(stale.feed());
+
+    // Dropping the stale handle leaves the new registration alone
+    stale.reset();
+    TEST_ASSERT_TRUE(fresh.feed());
+    TEST_ASSERT_EQUAL(1, wd.getRegisteredTaskCount());
+
+    fresh.reset();
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+    wd.deinit();
+}
+
+static constexpr Watchdog::StaticTaskSpec STATIC_TASKS[] = {
+    {"Sensor", 1000, true},
+    {"Network", 2000, false},
+};
+static_assert(Watchdog::validStaticTasks(STATIC_TASKS, 10), "Bad static task table");
+static constexpr size_t NETWORK_TASK = Watchdog::staticTaskIndex(STATIC_TASKS, "Network");
+static_assert(NETWORK_TASK == 1, "staticTaskIndex() must find the task");
+
+static volatile bool staticBindersGo = false;
+static volatile int staticBinds = 0;
+static volatile int staticBindersDone = 0;
+
+static void staticBinder(void*) {
+    Watchdog& wd = Watchdog::getInstance();
+    // Both binders wake on the same tick
+    while (!staticBindersGo) {
+        vTaskDelay(1);
+    }
+    bool bound = wd.bindStaticTask(0);
+    if (bound) {
+        __atomic_fetch_add(&staticBinds, 1, __ATOMIC_RELAXED);
+    }
+    // Wait for the other binder before releasing the slot
+    __atomic_fetch_add(&staticBindersDone, 1, __ATOMIC_ACQ_REL);
+    while (__atomic_load_n(&staticBindersDone, __ATOMIC_ACQUIRE) < 2) {
+        vTaskDelay(1);
+    }
+    if (bound) {
+        wd.unregisterCurrentTask();
+    }
+    __atomic_fetch_add(&staticBindersDone, 1, __ATOMIC_RELEASE);
+    vTaskDelete(nullptr);
+}
+
+void test_static_tasks_bind_to_reserved_slots() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false, STATIC_TASKS));
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+
+    // Dynamic registrations never take a reserved slot
+    Watchdog::HeartbeatId ids[Watchdog::MAX_TASKS + 1];
+    size_t dynamic = 0;
+    while ((ids[dynamic] = wd.registerHeartbeat("Dyn", 1000)) != Watchdog::INVALID_HEARTBEAT) {
+        dynamic++;
+    }
+    TEST_ASSERT_EQUAL(Watchdog::MAX_TASKS - 2, dynamic);
+
+    size_t freeBefore = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    TEST_ASSERT_TRUE(wd.bindStaticTask(NETWORK_TASK));
+    TEST_ASSERT_EQUAL(freeBefore, heap_caps_get_free_size(MALLOC_CAP_DEFAULT));
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Network", info));
+    TEST_ASSERT_EQUAL(2000, info.feedIntervalMs);
+    TEST_ASSERT_FALSE(info.isCritical);
+    TEST_ASSERT_FALSE(wd.getTaskInfo("Sensor", info));  // Not bound yet
+    TEST_ASSERT_TRUE(wd.feed());
+
+    // Unregistering keeps the slot reserved for the task
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+    TEST_ASSERT_EQUAL(Watchdog::INVALID_HEARTBEAT, wd.registerHeartbeat("Dyn", 1000));
+    TEST_ASSERT_TRUE(wd.bindStaticTask(NETWORK_TASK));
+    TEST_ASSERT_FALSE(wd.bindStaticTask(2));
+    // A registered task cannot take a second slot
+    TEST_ASSERT_FALSE(wd.bindStaticTask(0));
+    TEST_ASSERT_FALSE(wd.getTaskInfo("Sensor", info));
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+
+    for (size_t i = 0; i < dynamic; i++) {
+        TEST_ASSERT_TRUE(wd.unregisterHeartbeat(ids[i]));
+    }
+
+    // Tasks on both cores racing for one static slot: exactly one binds
+    for (int round = 0; round < 50; round++) {
+        staticBinds = 0;
+        staticBindersDone = 0;
+        staticBindersGo = false;
+        xTaskCreatePinnedToCore(staticBinder, "Bind0", 3072, nullptr, 5, nullptr, 0);
+        xTaskCreatePinnedToCore(staticBinder, "Bind1", 3072, nullptr, 5, nullptr, 1);
+        vTaskDelay(1);
+        staticBindersGo = true;
+        while (__atomic_load_n(&staticBindersDone, __ATOMIC_ACQUIRE) < 4) {
+            vTaskDelay(1);
+        }
+        TEST_ASSERT_EQUAL(1, staticBinds);
+        TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+    }
+    wd.deinit();
+
+    // Without a table every slot is dynamic again
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    dynamic = 0;
+    while ((ids[dynamic] = wd.registerHeartbeat("Dyn", 1000)) != Watchdog::INVALID_HEARTBEAT) {
+        dynamic++;
+    }
+    TEST_ASSERT_EQUAL(Watchdog::MAX_TASKS, dynamic);
+    wd.deinit();
+}
+
+// Registered by handle from the test task; keeps feeding so that its TWDT
+// subscription never holds the shared timer back
+static void feedingTask(void*) {
+    while (true) {
+        Watchdog::getInstance().feed();
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+}
+
+void test_bulk_registration() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    TaskHandle_t handles[3];
+    const char* names[3] = {"BulkA", "BulkB", nullptr};
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(feedingTask, "BulkC", 2048, nullptr, 1,
+                                              &handles[i]));
+    }
+    Watchdog::TaskRegistration tasks[] = {
+        {handles[0], names[0], 500, true},
+        {handles[1], names[1], 0, false},
+        {handles[2], names[2], 800, false},  // Registered under its FreeRTOS name
+        {handles[0], names[0], 500, true},   // Duplicate: counted, not registered twice
+    };
+    TEST_ASSERT_EQUAL(4, wd.registerTasks(tasks, 4));
+    TEST_ASSERT_EQUAL(3, wd.getRegisteredTaskCount());
+
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.getTaskInfo("BulkA", info));
+    TEST_ASSERT_EQUAL(handles[0], info.handle);
+    TEST_ASSERT_TRUE(info.isCritical);
+    TEST_ASSERT_TRUE(info.twdtSubscribed);
+    TEST_ASSERT_TRUE(wd.getTaskInfo("BulkC", info));
+    TEST_ASSERT_EQUAL(handles[2], info.handle);
+    TEST_ASSERT_EQUAL(800, info.feedIntervalMs);
+
+    // Unknown handles are skipped
+    TaskHandle_t removed[] = {handles[1], handles[1], xTaskGetCurrentTaskHandle()};
+    TEST_ASSERT_EQUAL(1, wd.unregisterTasks(removed, 3));
+    TEST_ASSERT_FALSE(wd.getTaskInfo("BulkB", info));
+    TEST_ASSERT_EQUAL(2, wd.getRegisteredTaskCount());
+
+    // deinit() releases the rest in one pass; a new run starts empty
+    wd.deinit();
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    TEST_ASSERT_FALSE(wd.getTaskInfo("BulkA", info));
+    TEST_ASSERT_EQUAL(3, wd.registerTasks(tasks, 3));
+    TEST_ASSERT_EQUAL(3, wd.unregisterTasks(handles, 3));
+    wd.deinit();
+
+    for (int i = 0; i < 3; i++) {
+        vTaskDelete(handles[i]);
+    }
+}
+
+#if WATCHDOG_PENDING_REGISTRATIONS > 0
+static volatile int earlyTasksQueued = 0;
+static volatile bool earlyTasksStop = false;
+static volatile bool earlyTasksFed = true;
+
+static void earlyTask(void* param) {
+    Watchdog& wd = Watchdog::getInstance();
+    if (wd.registerCurrentTask(static_cast<const char*>(param), false, 100)) {
+        __atomic_fetch_add(&earlyTasksQueued, 1, __ATOMIC_RELEASE);
+    }
+    while (!earlyTasksStop) {
+        if (wd.isInitialized() && !wd.feed()) {
+            earlyTasksFed = false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+    wd.unregisterCurrentTask();
+    __atomic_fetch_sub(&earlyTasksQueued, 1, __ATOMIC_RELEASE);
+    vTaskDelete(nullptr);
+}
+
+void test_registration_before_init_is_applied_by_init() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_FALSE(wd.isInitialized());
+
+    // Tasks start and register before the watchdog exists
+    earlyTasksQueued = 0;
+    earlyTasksStop = false;
+    earlyTasksFed = true;
+    xTaskCreatePinnedToCore(earlyTask, "Early0", 3072, const_cast<char*>("Early0"), 5,
+                            nullptr, 0);
+    xTaskCreatePinnedToCore(earlyTask, "Early1", 3072, const_cast<char*>("Early1"), 5,
+                            nullptr, 1);
+    while (__atomic_load_n(&earlyTasksQueued, __ATOMIC_ACQUIRE) < 2) {
+        vTaskDelay(1);
+    }
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+
+    // init() registers both in one batch; they are fed from then on
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    TEST_ASSERT_EQUAL(2, wd.getRegisteredTaskCount());
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Early0", info));
+    TEST_ASSERT_TRUE(info.twdtSubscribed);
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Early1", info));
+    vTaskDelay(pdMS_TO_TICKS(300));
+    TEST_ASSERT_EQUAL(0, wd.checkHealth());
+    TEST_ASSERT_TRUE(earlyTasksFed);
+
+    earlyTasksStop = true;
+    while (__atomic_load_n(&earlyTasksQueued, __ATOMIC_ACQUIRE) > 0) {
+        vTaskDelay(1);
+    }
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+    wd.deinit();
+}
+
+void test_withdrawn_queue_entries_are_reused() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_FALSE(wd.isInitialized());
+
+    // Far more register/unregister cycles than the queue has entries
+    for (size_t i = 0; i < 4 * Watchdog::PENDING_REGISTRATIONS; i++) {
+        TEST_ASSERT_TRUE(wd.registerCurrentTask("Churn", false, 1000));
+        TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+    }
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("Kept", false, 1000));
+
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    TEST_ASSERT_EQUAL(1, wd.getRegisteredTaskCount());
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Kept", info));
+    TEST_ASSERT_FALSE(wd.getTaskInfo("Churn", info));
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+    wd.deinit();
+}
+
+static volatile int leavingTasksQueued = 0;
+static volatile int leavingTasksDone = 0;
+static volatile bool leavingTasksGo = false;
+
+static void leavingTask(void* param) {
+    Watchdog& wd = Watchdog::getInstance();
+    if (wd.registerCurrentTask(static_cast<const char*>(param), false, 1000)) {
+        __atomic_fetch_add(&leavingTasksQueued, 1, __ATOMIC_RELEASE);
+    }
+    // Unregister the moment init() starts, while it may be applying the
+    // queue. Spins at the test task's priority, so it cannot starve it.
+    while (!leavingTasksGo) {
+        taskYIELD();
+    }
+    (void)wd.unregisterCurrentTask();
+    __atomic_fetch_add(&leavingTasksDone, 1, __ATOMIC_RELEASE);
+    vTaskSuspend(nullptr);
+}
+
+void test_unregister_during_init_leaves_no_subscription() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_FALSE(wd.isInitialized());
+
+    leavingTasksQueued = 0;
+    leavingTasksDone = 0;
+    leavingTasksGo = false;
+    TaskHandle_t tasks[2];
+    xTaskCreatePinnedToCore(leavingTask, "Leave0", 3072, const_cast<char*>("Leave0"),
+                            uxTaskPriorityGet(nullptr), &tasks[0], 0);
+    xTaskCreatePinnedToCore(leavingTask, "Leave1", 3072, const_cast<char*>("Leave1"),
+                            uxTaskPriorityGet(nullptr), &tasks[1], 1);
+    while (__atomic_load_n(&leavingTasksQueued, __ATOMIC_ACQUIRE) < 2) {
+        vTaskDelay(1);
+    }
+
+    leavingTasksGo = true;
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    while (__atomic_load_n(&leavingTasksDone, __ATOMIC_ACQUIRE) < 2) {
+        vTaskDelay(1);
+    }
+
+    // Whether each call withdrew the entry or removed the applied
+    // registration, neither task may be left subscribed to the TWDT
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_task_wdt_status(tasks[i]));
+        vTaskDelete(tasks[i]);
+    }
+    wd.deinit();
+}
+#endif
+
+static volatile bool infoReaderStop = false;
+static volatile uint32_t infoReads = 0;
+static volatile uint32_t infoErrors = 0;
+
+static void infoReader(void*) {
+    Watchdog& wd = Watchdog::getInstance();
+    while (!infoReaderStop) {
+        Watchdog::TaskInfo info;
+        if (!wd.getTaskInfo("Flaky", info) || strcmp(info.name, "Flaky") != 0 ||
+            info.feedIntervalMs != 20) {
+            infoErrors++;
+        } else if (info.missedFeeds > 0 &&
+                   xTaskGetTickCount() - info.lastFeedTime <= pdMS_TO_TICKS(40)) {
+            // A missed-feed count must come with the feed time it was judged on
+            infoErrors++;
+        }
+        // Entries that share a slot never mix their fields
+        if (wd.getTaskInfo("Odd", info) &&
+            (strcmp(info.name, "Odd") != 0 || info.feedIntervalMs != 300)) {
+            infoErrors++;
+        }
+        if (wd.getTaskInfo("Even", info) &&
+            (strcmp(info.name, "Even") != 0 || info.feedIntervalMs != 400)) {
+            infoErrors++;
+        }
+        infoReads++;
+    }
+    infoReaderStop = false;
+    vTaskDelete(nullptr);
+}
+
+void test_task_info_reads_are_consistent() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    Watchdog::HeartbeatId flaky = wd.registerHeartbeat("Flaky", 20);
+    TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, flaky);
+
+    // A reader on the other core copies entries while this core feeds
+    // irregularly, runs health passes and reuses slots
+    infoReads = 0;
+    infoErrors = 0;
+    xTaskCreatePinnedToCore(infoReader, "Reader", 3072, nullptr, 5, nullptr, 1);
+    for (int i = 0; i < 500; i++) {
+        if (i % 8 != 0) {
+            TEST_ASSERT_TRUE(wd.feedHeartbeat(flaky));
+        }
+        Watchdog::HeartbeatId churn = wd.registerHeartbeat(i & 1 ? "Odd" : "Even",
+                                                           i & 1 ? 300 : 400);
+        TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, churn);
+        wd.checkHealth();
+        TEST_ASSERT_TRUE(wd.unregisterHeartbeat(churn));
+        vTaskDelay(pdMS_TO_TICKS(i % 8 ? 5 : 60));
+    }
+    infoReaderStop = true;
+    while (infoReaderStop) {
+        vTaskDelay(1);
+    }
+
+    Serial.printf("TaskInfo reads during 500 health passes: %lu\n", infoReads);
+    TEST_ASSERT_EQUAL(0, infoErrors);
+    TEST_ASSERT_GREATER_THAN(0, infoReads);
+
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(flaky));
+    wd.deinit();
+}
+
+static volatile bool staleFeederStop = false;
+static volatile Watchdog::HeartbeatId staleFeederTarget = Watchdog::INVALID_HEARTBEAT;
+
+static void staleFeeder(void*) {
+    Watchdog& wd = Watchdog::getInstance();
+    while (!staleFeederStop) {
+        wd.feedHeartbeat(staleFeederTarget);
+    }
+    staleFeederStop = false;
+    vTaskDelete(nullptr);
+}
+
+void test_stale_feeds_leave_reused_slots_alone() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+    // A feeder on the other core keeps feeding each heartbeat while it is
+    // released and its slot reused; a feed that passed its id check just
+    // before the release must not move the new heartbeat's deadline
+    uint32_t moved = 0;
+    xTaskCreatePinnedToCore(staleFeeder, "Feeder", 3072, nullptr, 5, nullptr, 1);
+    for (int i = 0; i < 500; i++) {
+        Watchdog::HeartbeatId old = wd.registerHeartbeat("Old", 60000);
+        TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, old);
+        staleFeederTarget = old;
+        vTaskDelay(1);
+        TEST_ASSERT_TRUE(wd.unregisterHeartbeat(old));
+        Watchdog::HeartbeatId reused = wd.registerHeartbeat("New", 60000);
+        TEST_ASSERT_EQUAL(old & 0xFFFF, reused & 0xFFFF);
+
+        Watchdog::TaskInfo before;
+        Watchdog::TaskInfo after;
+        TEST_ASSERT_TRUE(wd.getTaskInfo("New", before));
+        vTaskDelay(2);
+        TEST_ASSERT_TRUE(wd.getTaskInfo("New", after));
+        if (after.lastFeedTime.load() != before.lastFeedTime.load()) {
+            moved++;
+        }
+        TEST_ASSERT_TRUE(wd.unregisterHeartbeat(reused));
+    }
+    staleFeederStop = true;
+    while (staleFeederStop) {
+        vTaskDelay(1);
+    }
+
+    TEST_ASSERT_EQUAL(0, moved);
+    wd.deinit();
+}
+
+#ifdef WATCHDOG_REGISTRY_SNAPSHOTS
+static volatile bool snapshotReaderStop = false;
+static volatile uint32_t snapshotReads = 0;
+static volatile uint32_t snapshotErrors = 0;
+
+static void snapshotReader(void*) {
+    Watchdog& wd = Watchdog::getInstance();
+    while (!snapshotReaderStop) {
+        Watchdog::TaskInfo info;
+        if (!wd.getTaskInfo("Stable", info) || !info.isHeartbeat) {
+            snapshotErrors++;
+        }
+        size_t visited = wd.forEachTask([](const Watchdog::TaskInfo& entry) {
+            if (entry.name[0] == '\0') {
+                snapshotErrors++;
+            }
+        });
+        if (visited == 0) {
+            snapshotErrors++;
+        }
+        snapshotReads++;
+    }
+    snapshotReaderStop = false;
+    vTaskDelete(nullptr);
+}
+
+void test_snapshot_readers_never_see_partial_updates() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+    Watchdog::HeartbeatId stable = wd.registerHeartbeat("Stable", 1000);
+    TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, stable);
+    uint32_t version = wd.getSnapshotVersion();
+
+    // Readers on the other core walk snapshots while registrations churn
+    snapshotReads = 0;
+    snapshotErrors = 0;
+    xTaskCreatePinnedToCore(snapshotReader, "Reader", 3072, nullptr, 5, nullptr, 1);
+    for (int i = 0; i < 500; i++) {
+        Watchdog::HeartbeatId churn = wd.registerHeartbeat("Churn", 1000);
+        TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, churn);
+        TEST_ASSERT_TRUE(wd.unregisterHeartbeat(churn));
+    }
+    snapshotReaderStop = true;
+    while (snapshotReaderStop) {
+        vTaskDelay(1);
+    }
+
+    Serial.printf("Snapshot reads during 1000 publications: %lu\n", snapshotReads);
+    TEST_ASSERT_EQUAL(0, snapshotErrors);
+    TEST_ASSERT_GREATER_THAN(0, snapshotReads);
+    TEST_ASSERT_EQUAL(version + 1000, wd.getSnapshotVersion());
+
+    // Unregistered entries disappear from the next snapshot
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(stable));
+    TEST_ASSERT_FALSE(wd.getTaskInfo("Stable", info));
+    TEST_ASSERT_EQUAL(0, wd.forEachTask([](const Watchdog::TaskInfo&) {}));
+    wd.deinit();
+}
+#endif
+
+void test_registry_footprint() {
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_TRUE(wd.init(10, false));
+
+#ifdef WATCHDOG_COMPACT_TASKINFO
+    const char* layout = "compact";
+    // Intervals are rounded up to whole units
+    Watchdog::HeartbeatId heartbeat = wd.registerHeartbeat("Rounded", 1001);
+    Watchdog::TaskInfo info;
+    TEST_ASSERT_TRUE(wd.getTaskInfo("Rounded", info));
+    TEST_ASSERT_EQUAL(1000 + WATCHDOG_INTERVAL_UNIT_MS, info.feedIntervalMs);
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(heartbeat));
+
+    // Intervals that do not fit 16 bits are rejected, not shortened
+    TEST_ASSERT_EQUAL(Watchdog::INVALID_HEARTBEAT,
+                      wd.registerHeartbeat("TooLong", Watchdog::MAX_FEED_INTERVAL_MS + 1));
+    heartbeat = wd.registerHeartbeat("Longest", Watchdog::MAX_FEED_INTERVAL_MS);
+    TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, heartbeat);
+    TEST_ASSERT_TRUE(wd.unregisterHeartbeat(heartbeat));
+
+#if WATCHDOG_NAME_TABLE_SIZE >= WATCHDOG_MAX_TASKS
+    // The default name table holds a distinct name for every slot
+    Watchdog::HeartbeatId named[Watchdog::MAX_TASKS];
+    for (size_t i = 0; i < Watchdog::MAX_TASKS; i++) {
+        char name[8];
+        snprintf(name, sizeof(name), "N%u", (unsigned)i);
+        named[i] = wd.registerHeartbeat(name, 1000);
+        TEST_ASSERT_NOT_EQUAL(Watchdog::INVALID_HEARTBEAT, named[i]);
+    }
+    for (size_t i = 0; i < Watchdog::MAX_TASKS; i++) {
+        TEST_ASSERT_TRUE(wd.unregisterHeartbeat(named[i]));
+    }
+#endif
+#else
+    const char* layout = "full";
+#endif
+#ifdef WATCHDOG_COLD_IN_PSRAM
+    const char* coldPlacement = "PSRAM";
+#else
+    const char* coldPlacement = "internal RAM";
+#endif
+    Serial.printf("Registry (%s): %u bytes per slot, %u bytes for %u slots, "
+                  "%u of them cold in %s\n", layout,
+                  (unsigned)Watchdog::SLOT_BYTES, (unsigned)Watchdog::REGISTRY_BYTES,
+                  (unsigned)Watchdog::MAX_TASKS, (unsigned)Watchdog::COLD_BYTES, coldPlacement);
+    Serial.printf("Free internal heap: %u bytes\n",
+                  (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+
+    wd.deinit();
+}
+
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_registration_does_not_allocate);
+    RUN_TEST(test_registry_full);
+    RUN_TEST(test_concurrent_claims_get_distinct_slots);
+    RUN_TEST(test_health_passes_per_core);
+    RUN_TEST(test_lookup_by_name_and_handle);
+    RUN_TEST(test_stale_ids_are_rejected);
+    RUN_TEST(test_static_tasks_bind_to_reserved_slots);
+    RUN_TEST(test_bulk_registration);
+#if WATCHDOG_PENDING_REGISTRATIONS > 0
+    RUN_TEST(test_registration_before_init_is_applied_by_init);
+    RUN_TEST(test_withdrawn_queue_entries_are_reused);
+    RUN_TEST(test_unregister_during_init_leaves_no_subscription);
+#endif
+    RUN_TEST(test_task_info_reads_are_consistent);
+    RUN_TEST(test_stale_feeds_leave_reused_slots_alone);
+#ifdef WATCHDOG_REGISTRY_SNAPSHOTS
+    RUN_TEST(test_snapshot_readers_never_see_partial_updates);
+#endif
+    RUN_TEST(test_registry_footprint);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty
+}
@@ -7,6 +7,42 @@
 #include <unity.h>
 #include <Watchdog.h>
 
+// Runs during static initialization, before setup() and before the
+// scheduler starts
+struct EarlyUser {
+    Watchdog* instance;
+    bool initialized;
+    bool foundTask;
+    
+    EarlyUser() {
+        Watchdog& wd = Watchdog::getInstance();
+        instance = &wd;
+        initialized = wd.isInitialized();
+        Watchdog::TaskInfo info;
+        foundTask = wd.getTaskInfo("Early", info);
+    }
+};
+static EarlyUser earlyUser;
+
+void test_singleton_usable_from_global_constructors() {
+    TEST_ASSERT_EQUAL(&Watchdog::getInstance(), earlyUser.instance);
+    TEST_ASSERT_FALSE(earlyUser.initialized);
+    TEST_ASSERT_FALSE(earlyUser.foundTask);
+    
+    // Before init() nothing is registered and nothing blocks
+    Watchdog& wd = Watchdog::getInstance();
+    TEST_ASSERT_EQUAL(0, wd.checkHealth());
+#if WATCHDOG_PENDING_REGISTRATIONS > 0
+    // Task registrations wait for init(); this one is withdrawn again
+    TEST_ASSERT_TRUE(wd.registerCurrentTask("Early", false, 1000));
+    TEST_ASSERT_EQUAL(0, wd.getRegisteredTaskCount());
+    TEST_ASSERT_TRUE(wd.unregisterCurrentTask());
+#else
+    TEST_ASSERT_FALSE(wd.registerCurrentTask("Early", false, 1000));
+#endif
+    TEST_ASSERT_EQUAL(Watchdog::INVALID_HEARTBEAT, wd.registerHeartbeat("Early", 1000));
+}
+
 void test_singleton_same_instance() {
     // Get instance multiple times
     Watchdog& wd1 = Watchdog::getInstance();
@@ -82,6 +118,7 @@ void setup() {
     delay(2000);
     UNITY_BEGIN();
     
+    RUN_TEST(test_singleton_usable_from_global_constructors);
     RUN_TEST(test_singleton_same_instance);
     RUN_TEST(test_singleton_static_methods);
     RUN_TEST(test_singleton_shared_state);